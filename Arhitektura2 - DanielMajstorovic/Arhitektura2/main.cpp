@@ -1,17 +1,102 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <memory>
+#include <random>
+#include <cstdio>
 #include "Convolution_NoOpt.h"
 #include "Convolution_O1Opt.h"
 #include "Convolution_O2Opt.h"
 #include "Convolution_OXOpt.h"
 #include "ConvolutionUsingIntrinsicFunctions.h"
+#include "ConvolutionWorkspace.h"
+#include "NumaPlacement.h"
+#include "Convolution_Separable.h"
+#include "Convolution_FFT.h"
+#include "Convolution_Planar.h"
+#include "Convolution_FixedPoint.h"
+#include "Convolution_FixedSize.h"
+#include "Convolution_Streaming.h"
+#include "Convolution_Fused.h"
+#include "Convolution_Strided.h"
+#include "Convolution_Incremental.h"
+#include "Convolution_MixedPrecision.h"
+#include "Convolution_Winograd.h"
+#include "Convolution_Box.h"
+#include "Convolution_RecursiveGaussian.h"
+#include "ConvolutionArguments.h"
+#include "BatchPipeline.h"
+#include "FramePipeline.h"
+#include "DistributedConvolution.h"
+#include "CacheInfo.h"
+#include "CacheMissCounters.h"
+#include "TiledExecution.h"
 
 std::string modifyFileName(const std::string& originalPath, const std::string& suffix);
 std::string removeFirstTwoLines(const std::string& input);
+int runTilingBenchmark(int argc, char* argv[]);
+int runStreaming(int argc, char* argv[]);
+int runBatch(int argc, char* argv[]);
+int runPyramid(int argc, char* argv[]);
+int runVideo(int argc, char* argv[]);
+int runDistributed(int argc, char* argv[]);
+int runGaussian(int argc, char* argv[]);
+template <class Convolution>
+std::function<void(const Mat&, Mat&)> makeBatchConvolution(int argc, char* argv[]);
+std::function<void(const Mat&, Mat&)> selectBatchConvolution(int argc, char* argv[]);
+std::function<Mat(const Mat&)> allocatingConvolution(const std::function<void(const Mat&, Mat&)>& convolution);
+template <class Convolution>
+std::string benchmarkTiling(const std::string& label, Convolution& convolution, CacheMissCounters& counters);
+std::string describeMisses(const std::string& level, long long untiled, long long tiled);
+int runRegression(int argc, char* argv[]);
 
 int main(int argc, char* argv[]) {
 
+    ConvolutionArguments arguments(argc, argv);
+
+    // --affinity=compact|scatter vezuje niti skupa za procesore; zadaje se prije prvog paralelnog poziva
+    setAffinityPolicy(selectAffinityPolicy(arguments.getOption("affinity", "")));
+
+    // --regression poredi nove varijante, paketnu obradu i obradu okvira sa Convolution_NoOpt
+    if (arguments.hasOption("regression")) {
+        return runRegression(argc, argv);
+    }
+
+    // --benchmark=tiling poredi blokovsko i obicno izvrsavanje (vrijeme i promasaji kesa)
+    if (arguments.getOption("benchmark", "") == "tiling") {
+        return runTilingBenchmark(argc, argv);
+    }
+
+    // --stream obradjuje sliku u pojasevima direktno u izlazni fajl, bez ucitavanja cijele slike
+    if (arguments.hasOption("stream")) {
+        return runStreaming(argc, argv);
+    }
+
+    // --batch: ulaz je direktorijum ili lista slika, izlaz direktorijum za rezultate
+    if (arguments.hasOption("batch")) {
+        return runBatch(argc, argv);
+    }
+
+    // --video: ulaz je video ili niz slika (okvir_%04d.png), okviri se racunaju uz dvostruko baferovanje
+    if (arguments.hasOption("video")) {
+        return runVideo(argc, argv);
+    }
+
+    // --distributed=N: slika podijeljena na blokove izmedju 1, 2, 4, ... N radnih procesa uz razmjenu oreola
+    if (arguments.hasOption("distributed")) {
+        return runDistributed(argc, argv);
+    }
+
+    // --pyramid=N: Gausova i Laplasova piramida sa N nivoa, racunaju se samo zadrzani pikseli
+    if (arguments.hasOption("pyramid")) {
+        return runPyramid(argc, argv);
+    }
+
+    // --sigma=S: Gausovo zamucenje rekurzivnim filtrom umjesto kernela iz argumenata
+    if (arguments.hasOption("sigma")) {
+        return runGaussian(argc, argv);
+    }
+
     std::ofstream outFile("rezultati.txt");
 
     if (!outFile.is_open()) {
@@ -19,41 +104,142 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Izlazna putanja je drugi pozicioni argument; opcije --ime=vrijednost mogu stajati bilo gdje
+    std::string outputPath = arguments.getOutputFilePath();
+
+    // Pet osnovnih varijanti se izvrsava jedna za drugom, pa dijele iste bafere (prosirena slika, akumulator, izlaz)
+    std::shared_ptr<ConvolutionWorkspace> legacyWorkspace = std::make_shared<ConvolutionWorkspace>(parseNumaPlacement(arguments.getOption("numa", "aware")), parseHugePages(arguments.getOption("hugepages", "off")));
     Convolution_NoOpt cNoOpt(argc, argv);
+    cNoOpt.setWorkspace(legacyWorkspace);
     std::string noOptTestResult = cNoOpt.test();
     std::cout << noOptTestResult << std::endl;
-    imwrite(modifyFileName(argv[2], "NoOptSeq"), cNoOpt.performConvolution());
-    imwrite(modifyFileName(argv[2], "NoOptPar"), cNoOpt.performParallelConvolution());
+    imwrite(modifyFileName(outputPath, "NoOptSeq"), cNoOpt.performConvolution());
+    imwrite(modifyFileName(outputPath, "NoOptPar"), cNoOpt.performParallelConvolution());
     outFile << noOptTestResult;
 
     Convolution_O1Opt cO1Opt(argc, argv);
+    cO1Opt.setWorkspace(legacyWorkspace);
     std::string o1OptTestResult = cO1Opt.test();
     std::cout << o1OptTestResult << std::endl;
-    imwrite(modifyFileName(argv[2], "O1OptSeq"), cO1Opt.performConvolution());
-    imwrite(modifyFileName(argv[2], "O1OptPar"), cO1Opt.performParallelConvolution());
+    imwrite(modifyFileName(outputPath, "O1OptSeq"), cO1Opt.performConvolution());
+    imwrite(modifyFileName(outputPath, "O1OptPar"), cO1Opt.performParallelConvolution());
     outFile << removeFirstTwoLines(o1OptTestResult);
 
     Convolution_O2Opt cO2Opt(argc, argv);
+    cO2Opt.setWorkspace(legacyWorkspace);
     std::string o2OptTestResult = cO2Opt.test();
     std::cout << o2OptTestResult << std::endl;
-    imwrite(modifyFileName(argv[2], "O2OptSeq"), cO2Opt.performConvolution());
-    imwrite(modifyFileName(argv[2], "O2OptPar"), cO2Opt.performParallelConvolution());
+    imwrite(modifyFileName(outputPath, "O2OptSeq"), cO2Opt.performConvolution());
+    imwrite(modifyFileName(outputPath, "O2OptPar"), cO2Opt.performParallelConvolution());
     outFile << removeFirstTwoLines(o2OptTestResult);
 
     Convolution_OXOpt cOXOpt(argc, argv);
+    cOXOpt.setWorkspace(legacyWorkspace);
     std::string oXOptTestResult = cOXOpt.test();
     std::cout << oXOptTestResult << std::endl;
-    imwrite(modifyFileName(argv[2], "OXOptSeq"), cOXOpt.performConvolution());
-    imwrite(modifyFileName(argv[2], "OXOptPar"), cOXOpt.performParallelConvolution());
+    imwrite(modifyFileName(outputPath, "OXOptSeq"), cOXOpt.performConvolution());
+    imwrite(modifyFileName(outputPath, "OXOptPar"), cOXOpt.performParallelConvolution());
     outFile << removeFirstTwoLines(oXOptTestResult);
 
     ConvolutionUsingIntrinsicFunctions cUIF(argc, argv);
+    cUIF.setWorkspace(legacyWorkspace);
     std::string uifTestResult = cUIF.test();
     std::cout << uifTestResult << std::endl;
-    imwrite(modifyFileName(argv[2], "IntrinsicsSeq"), cUIF.performConvolution());
-    imwrite(modifyFileName(argv[2], "IntrinsicsPar"), cUIF.performParallelConvolution());
+    imwrite(modifyFileName(outputPath, "IntrinsicsSeq"), cUIF.performConvolution());
+    imwrite(modifyFileName(outputPath, "IntrinsicsPar"), cUIF.performParallelConvolution());
     outFile << removeFirstTwoLines(uifTestResult);
 
+    Convolution_Separable cSeparable(argc, argv);
+    std::string separableTestResult = cSeparable.test();
+    std::cout << separableTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "SeparableSeq"), cSeparable.performConvolution());
+    imwrite(modifyFileName(outputPath, "SeparablePar"), cSeparable.performParallelConvolution());
+    outFile << removeFirstTwoLines(separableTestResult);
+
+    Convolution_FFT cFFT(argc, argv);
+    std::string fftTestResult = cFFT.test();
+    std::cout << fftTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "FFTSeq"), cFFT.performConvolution());
+    imwrite(modifyFileName(outputPath, "FFTPar"), cFFT.performParallelConvolution());
+    outFile << removeFirstTwoLines(fftTestResult);
+
+    Convolution_Planar cPlanar(argc, argv);
+    std::string planarTestResult = cPlanar.test();
+    std::cout << planarTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "PlanarSeq"), cPlanar.performConvolution());
+    imwrite(modifyFileName(outputPath, "PlanarPar"), cPlanar.performParallelConvolution());
+    outFile << removeFirstTwoLines(planarTestResult);
+
+    Convolution_FixedPoint cFixedPoint(argc, argv);
+    std::string fixedPointTestResult = cFixedPoint.test();
+    std::cout << fixedPointTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "FixedPointSeq"), cFixedPoint.performConvolution());
+    imwrite(modifyFileName(outputPath, "FixedPointPar"), cFixedPoint.performParallelConvolution());
+    outFile << removeFirstTwoLines(fixedPointTestResult);
+
+    Convolution_FixedSize cCFixedSize(argc, argv);
+    std::string cFixedSizeTestResult = cCFixedSize.test();
+    std::cout << cFixedSizeTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "FixedSizeSeq"), cCFixedSize.performConvolution());
+    imwrite(modifyFileName(outputPath, "FixedSizePar"), cCFixedSize.performParallelConvolution());
+    outFile << removeFirstTwoLines(cFixedSizeTestResult);
+
+    // Obrada u pojasevima ne podrzava wrap, pa se tada preskace umjesto da prekine ostala mjerenja
+    if (parseBorderMode(arguments.getOption("border", "zero")) != BorderWrap) {
+        Convolution_Streaming cCStreaming(argc, argv);
+        std::string cStreamingTestResult = cCStreaming.test();
+        std::cout << cStreamingTestResult << std::endl;
+        imwrite(modifyFileName(outputPath, "StreamingSeq"), cCStreaming.performConvolution());
+        imwrite(modifyFileName(outputPath, "StreamingPar"), cCStreaming.performParallelConvolution());
+        outFile << removeFirstTwoLines(cStreamingTestResult);
+    }
+    else {
+        std::cout << "Tok u pojasevima: preskoceno, --border=wrap nije podrzan" << std::endl;
+        outFile << "Tok u pojasevima: preskoceno, --border=wrap nije podrzan\n";
+    }
+
+    Convolution_Fused cFused(argc, argv);
+    std::string fusedTestResult = cFused.test();
+    std::cout << fusedTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "FusedSeq"), cFused.performConvolution());
+    imwrite(modifyFileName(outputPath, "FusedPar"), cFused.performParallelConvolution());
+    outFile << removeFirstTwoLines(fusedTestResult);
+
+    Convolution_Strided cStrided(argc, argv);
+    std::string stridedTestResult = cStrided.test();
+    std::cout << stridedTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "StridedSeq"), cStrided.performConvolution());
+    imwrite(modifyFileName(outputPath, "StridedPar"), cStrided.performParallelConvolution());
+    outFile << removeFirstTwoLines(stridedTestResult);
+
+    Convolution_Incremental cIncremental(argc, argv);
+    std::string incrementalTestResult = cIncremental.test();
+    std::cout << incrementalTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "IncrementalSeq"), cIncremental.performConvolution());
+    imwrite(modifyFileName(outputPath, "IncrementalPar"), cIncremental.performParallelConvolution());
+    outFile << removeFirstTwoLines(incrementalTestResult);
+
+    Convolution_MixedPrecision cMixedPrecision(argc, argv);
+    std::string mixedPrecisionTestResult = cMixedPrecision.test();
+    std::cout << mixedPrecisionTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "MixedPrecisionSeq"), cMixedPrecision.performConvolution());
+    imwrite(modifyFileName(outputPath, "MixedPrecisionPar"), cMixedPrecision.performParallelConvolution());
+    outFile << removeFirstTwoLines(mixedPrecisionTestResult);
+
+    Convolution_Winograd cWinograd(argc, argv);
+    std::string winogradTestResult = cWinograd.test();
+    std::cout << winogradTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "WinogradSeq"), cWinograd.performConvolution());
+    imwrite(modifyFileName(outputPath, "WinogradPar"), cWinograd.performParallelConvolution());
+    outFile << removeFirstTwoLines(winogradTestResult);
+
+    Convolution_Box cBox(argc, argv);
+    std::string boxTestResult = cBox.test();
+    std::cout << boxTestResult << std::endl;
+    imwrite(modifyFileName(outputPath, "BoxSeq"), cBox.performConvolution());
+    imwrite(modifyFileName(outputPath, "BoxPar"), cBox.performParallelConvolution());
+    outFile << removeFirstTwoLines(boxTestResult);
+
     outFile.close();
 
     return 0;
@@ -86,4 +272,554 @@ std::string removeFirstTwoLines(const std::string& input) {
     }
 
     return result;
+}
+
+int runTilingBenchmark(int argc, char* argv[]) {
+    // Brojaci se otvaraju prije prvog OpenMP regiona da bi ih naslijedile i radne niti
+    CacheMissCounters counters;
+
+    std::ofstream outFile("rezultati_blokovi.txt");
+
+    if (!outFile.is_open()) {
+        std::cerr << "Fajl nije otvoren!" << std::endl;
+        return 1;
+    }
+
+    ConvolutionArguments arguments(argc, argv);
+    Mat kernel = arguments.getKernel();
+    CacheSizes caches = detectCacheSizes();
+    TileShape tile = chooseTileShape(kernel.rows, kernel.cols, sizeof(Vec3d));
+
+    std::string log = "Kes: L1 " + std::to_string(caches.l1 / 1024) + " KB, L2 " + std::to_string(caches.l2 / 1024) + " KB, L3 " + std::to_string(caches.l3 / 1024) + " KB";
+    log += "\nBlok: " + std::to_string(tile.cols) + " x " + std::to_string(tile.rows) + " piksela za kernel " + std::to_string(kernel.cols) + " x " + std::to_string(kernel.rows);
+    if (!counters.isAvailable()) {
+        log += "\nBrojaci promasaja kesa nisu dostupni, prikazuje se samo vrijeme";
+    }
+    std::cout << log << std::endl;
+    outFile << log << "\n";
+
+    // Pet osnovnih varijanti se izvrsava jedna za drugom, pa dijele iste bafere (prosirena slika, akumulator, izlaz)
+    std::shared_ptr<ConvolutionWorkspace> legacyWorkspace = std::make_shared<ConvolutionWorkspace>(parseNumaPlacement(arguments.getOption("numa", "aware")), parseHugePages(arguments.getOption("hugepages", "off")));
+    Convolution_NoOpt cNoOpt(argc, argv);
+    cNoOpt.setWorkspace(legacyWorkspace);
+    log = benchmarkTiling("Bez optimizacija", cNoOpt, counters);
+    std::cout << log;
+    outFile << log;
+
+    Convolution_O1Opt cO1Opt(argc, argv);
+    cO1Opt.setWorkspace(legacyWorkspace);
+    log = benchmarkTiling("O1 optimizacija", cO1Opt, counters);
+    std::cout << log;
+    outFile << log;
+
+    Convolution_O2Opt cO2Opt(argc, argv);
+    cO2Opt.setWorkspace(legacyWorkspace);
+    log = benchmarkTiling("O2 optimizacija", cO2Opt, counters);
+    std::cout << log;
+    outFile << log;
+
+    Convolution_OXOpt cOXOpt(argc, argv);
+    cOXOpt.setWorkspace(legacyWorkspace);
+    log = benchmarkTiling("OX optimizacija", cOXOpt, counters);
+    std::cout << log;
+    outFile << log;
+
+    ConvolutionUsingIntrinsicFunctions cUIF(argc, argv);
+    cUIF.setWorkspace(legacyWorkspace);
+    log = benchmarkTiling("Intrinzicne funkcije", cUIF, counters);
+    std::cout << log;
+    outFile << log;
+
+    outFile.close();
+
+    return 0;
+}
+
+int runStreaming(int argc, char* argv[]) {
+    Convolution_Streaming cStreaming(argc, argv);
+
+    double start = omp_get_wtime();
+    cStreaming.performStreamingConvolution(true);
+    double end = omp_get_wtime();
+
+    std::cout << "Tok u pojasevima (" << cStreaming.getStreamingReport() << "): vrijeme " << end - start << " s" << std::endl;
+    std::cout << "Rezultat na putanji: " << ConvolutionArguments(argc, argv).getOutputFilePath() << std::endl;
+
+    return 0;
+}
+
+int runGaussian(int argc, char* argv[]) {
+    Convolution_RecursiveGaussian cGaussian(argc, argv);
+    std::string gaussianTestResult = cGaussian.test();
+    std::cout << gaussianTestResult << std::endl;
+    cGaussian.saveImage(cGaussian.performParallelConvolution());
+
+    std::ofstream outFile("rezultati_gaus.txt");
+    outFile << gaussianTestResult << "\n";
+
+    return 0;
+}
+
+template <class Convolution>
+std::string benchmarkTiling(const std::string& label, Convolution& convolution, CacheMissCounters& counters) {
+    std::function<Mat()> variants[4] = {
+        [&]() { return convolution.performConvolution(); },
+        [&]() { return convolution.performTiledConvolution(); },
+        [&]() { return convolution.performParallelConvolution(); },
+        [&]() { return convolution.performParallelTiledConvolution(); }
+    };
+    double times[4];
+    long long l1Misses[4], l2Misses[4], lastLevelMisses[4];
+
+    for (int i = 0; i < 4; i++) {
+        // Zagrijavanje, pa jedno mjereno izvrsavanje
+        variants[i]();
+        counters.start();
+        double start = omp_get_wtime();
+        variants[i]();
+        double end = omp_get_wtime();
+        counters.stop();
+        times[i] = end - start;
+        l1Misses[i] = counters.getL1Misses();
+        l2Misses[i] = counters.getL2Misses();
+        lastLevelMisses[i] = counters.getLastLevelMisses();
+    }
+
+    std::string log;
+    const char* modes[2] = { "sekvencijalno", "paralelno" };
+    for (int m = 0; m < 2; m++) {
+        int untiled = 2 * m;
+        int tiled = 2 * m + 1;
+        log += label + ", " + modes[m] + ": vrijeme " + std::to_string(times[untiled]) + " -> " + std::to_string(times[tiled]) + " s";
+        log += ", " + describeMisses("L1", l1Misses[untiled], l1Misses[tiled]);
+        log += ", " + describeMisses("L2", l2Misses[untiled], l2Misses[tiled]);
+        log += ", " + describeMisses("LLC", lastLevelMisses[untiled], lastLevelMisses[tiled]) + "\n";
+    }
+    return log;
+}
+
+std::string describeMisses(const std::string& level, long long untiled, long long tiled) {
+    if (untiled < 0 || tiled < 0) {
+        return level + " promasaji: nedostupno";
+    }
+    std::string description = level + " promasaji: " + std::to_string(untiled) + " -> " + std::to_string(tiled);
+    if (untiled > 0) {
+        description += " (smanjenje " + std::to_string(100.0 * (untiled - tiled) / untiled) + "%)";
+    }
+    return description;
+}
+
+int runPyramid(int argc, char* argv[]) {
+    ConvolutionArguments arguments(argc, argv);
+    int levels = arguments.getIntOption("pyramid", 6);
+    std::string outputPath = arguments.getOutputFilePath();
+    Convolution_Strided cStrided(argc, argv);
+
+    double start = omp_get_wtime();
+    std::vector<Mat> gaussian = cStrided.buildGaussianPyramid(levels, true);
+    double middle = omp_get_wtime();
+    std::vector<Mat> laplacian = cStrided.buildLaplacianPyramid(levels, true);
+    double end = omp_get_wtime();
+
+    std::cout << "Gausova piramida (" << gaussian.size() << " nivoa): vrijeme " << middle - start << " s" << std::endl;
+    std::cout << "Laplasova piramida (" << laplacian.size() << " nivoa): vrijeme " << end - middle << " s" << std::endl;
+
+    for (size_t k = 0; k < gaussian.size(); k++) {
+        imwrite(modifyFileName(outputPath, "G" + std::to_string(k)), gaussian[k]);
+    }
+    // Laplasovi nivoi su razlike (CV_16SC3), pa se za prikaz pomjeraju za 128
+    for (size_t k = 0; k < laplacian.size(); k++) {
+        Mat level = laplacian[k];
+        if (level.depth() == CV_16S) {
+            level.convertTo(level, CV_8UC3, 1, 128);
+        }
+        imwrite(modifyFileName(outputPath, "L" + std::to_string(k)), level);
+    }
+
+    return 0;
+}
+
+int runBatch(int argc, char* argv[]) {
+    ConvolutionArguments arguments(argc, argv);
+    std::function<void(const Mat&, Mat&)> convolution = selectBatchConvolution(argc, argv);
+    if (!convolution) {
+        return 1;
+    }
+
+    std::vector<String> inputs = BatchPipeline::listInputs(arguments.getInputFilePath());
+    BatchPipeline pipeline(arguments.getIntOption("decoders", 2), arguments.getIntOption("encoders", 2), arguments.getIntOption("queue", 8));
+    std::string report = pipeline.run(inputs, arguments.getOutputFilePath(), allocatingConvolution(convolution));
+    std::cout << report << std::endl;
+
+    return 0;
+}
+
+int runVideo(int argc, char* argv[]) {
+    ConvolutionArguments arguments(argc, argv);
+    std::function<void(const Mat&, Mat&)> convolution = selectBatchConvolution(argc, argv);
+    if (!convolution) {
+        return 1;
+    }
+
+    FramePipeline pipeline(arguments.getIntOption("buffers", 2), arguments.getOption("fourcc", "MJPG"));
+    std::string report = pipeline.run(arguments.getInputFilePath(), arguments.getOutputFilePath(), convolution, arguments.getIntOption("frames", 0));
+    std::cout << report << std::endl;
+
+    std::ofstream outFile("rezultati_video.txt");
+    outFile << report << "\n";
+
+    return 0;
+}
+
+int runDistributed(int argc, char* argv[]) {
+    ConvolutionArguments arguments(argc, argv);
+    int maxWorkers = std::max(arguments.getIntOption("distributed", 4), 1);
+
+    // Varijanta se pravi prije pokretanja radnika, koji je naslijede i racunaju njom svoje blokove
+    std::function<void(const Mat&, Mat&)> convolution = selectBatchConvolution(argc, argv);
+    if (!convolution) {
+        return 1;
+    }
+    Mat image = imread(arguments.getInputFilePath());
+    if (image.empty()) {
+        std::cerr << "Slika " << arguments.getInputFilePath() << " se ne moze ucitati" << std::endl;
+        return 1;
+    }
+    BorderMode borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+    // Rekurzivni Gaus nema kernel, a oreol mu je prosirenje od ceil(4 sigma) piksela
+    int haloKernelSize = arguments.getKernel().rows;
+    if (arguments.getOption("engine", "fixedsize") == "gaussian") {
+        haloKernelSize = 2 * (int)ceil(4 * arguments.getDoubleOption("sigma", 20.0)) + 1;
+    }
+    DistributedConvolution distributed(haloKernelSize, borderMode, arguments.getIntOption("worker-threads", 1), allocatingConvolution(convolution));
+
+    // Skaliranje: 1, 2, 4, ... radnika do zadatog broja; efikasnost je T1 / (n x Tn)
+    std::vector<int> workerCounts;
+    for (int workers = 1; workers < maxWorkers; workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(maxWorkers);
+
+    std::string log = "Dimenzija slike: " + std::to_string(image.cols) + " x " + std::to_string(image.rows) + ", ivice: " + getBorderModeName(borderMode);
+    Mat single;
+    Mat result;
+    double singleTime = 0;
+    for (int workers : workerCounts) {
+        DistributedRun run;
+        result = distributed.run(image, workers, run);
+        if (workers == 1) {
+            single = result;
+            singleTime = run.seconds;
+        }
+        log += "\nRadnika: " + std::to_string(workers) + " (mreza " + std::to_string(run.gridRows) + " x " + std::to_string(run.gridCols) + ")";
+        log += ", vrijeme: " + std::to_string(run.seconds) + " s, najduze racunanje: " + std::to_string(run.computeSeconds) + " s";
+        log += ", oreoli: " + std::to_string(run.haloBytes / 1024) + " KB";
+        log += ", ubrzanje: " + std::to_string(singleTime / run.seconds) + ", efikasnost: " + std::to_string(100 * singleTime / (workers * run.seconds)) + "%";
+        log += ", razlika od 1 radnika: " + std::to_string(norm(single, result, NORM_INF));
+    }
+    std::cout << log << std::endl;
+
+    std::ofstream outFile("rezultati_distribuirano.txt");
+    outFile << log << "\n";
+    imwrite(arguments.getOutputFilePath(), result);
+
+    return 0;
+}
+
+std::function<void(const Mat&, Mat&)> selectBatchConvolution(int argc, char* argv[]) {
+    ConvolutionArguments arguments(argc, argv);
+    std::string engine = arguments.getOption("engine", "fixedsize");
+
+    std::function<void(const Mat&, Mat&)> convolution;
+    if (engine == "fixedsize") {
+        convolution = makeBatchConvolution<Convolution_FixedSize>(argc, argv);
+    }
+    else if (engine == "planar") {
+        convolution = makeBatchConvolution<Convolution_Planar>(argc, argv);
+    }
+    else if (engine == "fixedpoint") {
+        convolution = makeBatchConvolution<Convolution_FixedPoint>(argc, argv);
+    }
+    else if (engine == "separable") {
+        convolution = makeBatchConvolution<Convolution_Separable>(argc, argv);
+    }
+    else if (engine == "fft") {
+        convolution = makeBatchConvolution<Convolution_FFT>(argc, argv);
+    }
+    else if (engine == "fused") {
+        convolution = makeBatchConvolution<Convolution_Fused>(argc, argv);
+    }
+    else if (engine == "gaussian") {
+        convolution = makeBatchConvolution<Convolution_RecursiveGaussian>(argc, argv);
+    }
+    else {
+        std::cerr << "Opcija --engine mora biti fixedsize, planar, fixedpoint, separable, fft, fused ili gaussian" << std::endl;
+    }
+    return convolution;
+}
+
+template <class Convolution>
+std::function<void(const Mat&, Mat&)> makeBatchConvolution(int argc, char* argv[]) {
+    // Jedan objekat za sve slike; faza racunanja je jedna nit, pa se setInputImage ne preklapa.
+    // Rezultat se upisuje u output, koji se alocira samo ako nema oblik ulaza; kopira se samo
+    // ako varijanta ipak vrati drugi bafer
+    std::shared_ptr<Convolution> convolution = std::make_shared<Convolution>(argc, argv);
+    return [convolution](const Mat& image, Mat& output) {
+        output.create(image.rows, image.cols, CV_8UC3);
+        convolution->setInputImage(image);
+        convolution->setOutputImage(output);
+        Mat result = convolution->performParallelConvolution();
+        if (result.data != output.data) {
+            result.copyTo(output);
+        }
+    };
+}
+
+std::function<Mat(const Mat&)> allocatingConvolution(const std::function<void(const Mat&, Mat&)>& convolution) {
+    // Nov izlaz za svaku sliku: paketna obrada kodira rezultat dok se racuna sljedeca slika
+    return [convolution](const Mat& image) {
+        Mat output;
+        convolution(image, output);
+        return output;
+    };
+}
+
+// Argumenti komandne linije sastavljeni u programu; pokazivaci vaze dok postoji objekat
+class RegressionArguments
+{
+    std::vector<std::string> values;
+    std::vector<char*> pointers;
+
+public:
+    RegressionArguments(const std::vector<std::string>& arguments) : values(arguments) {
+        for (std::string& value : values) {
+            pointers.push_back(&value[0]);
+        }
+    }
+    RegressionArguments(const RegressionArguments&) = delete;
+    RegressionArguments& operator=(const RegressionArguments&) = delete;
+    int count() { return (int)pointers.size(); }
+    char** data() { return pointers.data(); }
+};
+
+Mat randomImage(int rows, int cols, std::mt19937& generator) {
+    Mat image(rows, cols, CV_8UC3);
+    for (int x = 0; x < rows; x++) {
+        uchar* row = image.ptr<uchar>(x);
+        for (int y = 0; y < 3 * cols; y++) {
+            row[y] = (uchar)(generator() % 256);
+        }
+    }
+    return image;
+}
+
+std::vector<std::string> regressionArguments(const std::string& program, const std::string& inputPath, const std::string& outputPath, const Mat& kernel, const std::vector<std::string>& options) {
+    std::vector<std::string> arguments = { program, inputPath, outputPath };
+    for (int u = 0; u < kernel.rows; u++) {
+        for (int v = 0; v < kernel.cols; v++) {
+            std::ostringstream coefficient;
+            coefficient.precision(17);
+            coefficient << kernel.at<double>(u, v);
+            arguments.push_back(coefficient.str());
+        }
+    }
+    arguments.insert(arguments.end(), options.begin(), options.end());
+    return arguments;
+}
+
+// Najvece odstupanje sekvencijalnog i paralelnog izlaza varijante od reference
+template <class Convolution>
+double regressionError(RegressionArguments& arguments, const Mat& image, const Mat& reference) {
+    Convolution convolution(arguments.count(), arguments.data());
+    convolution.setInputImage(image.clone());
+    double error = norm(convolution.performConvolution(), reference, NORM_INF);
+    return std::max(error, norm(convolution.performParallelConvolution(), reference, NORM_INF));
+}
+
+std::string baseFileName(const std::string& path) {
+    size_t slashPosition = path.find_last_of("/\\");
+    return slashPosition == std::string::npos ? path : path.substr(slashPosition + 1);
+}
+
+int runRegression(int argc, char* argv[]) {
+    // Izlazni argument je prefiks privremenih fajlova (slike za streaming, paket i okvire)
+    ConvolutionArguments arguments(argc, argv);
+    std::string prefix = arguments.getOutputFilePath();
+    std::string program = argv[0];
+    std::mt19937 generator(arguments.getIntOption("seed", 1));
+    // Float i fiksni zarez mogu zaokruziti drugacije od double reference za jedan nivo
+    const double tolerance = 1;
+
+    int checks = 0;
+    int failures = 0;
+    std::string log;
+    auto check = [&](const std::string& label, double error) {
+        checks++;
+        if (error > tolerance) {
+            failures++;
+            log += "\nGRESKA " + label + ": odstupanje " + std::to_string(error);
+        }
+    };
+
+    // Varijante nad slikama manjim i vecim od kernela, za sve nacine prosirenja i tri vrste kernela:
+    // box (svi koeficijenti jednaki), rang 1 i opsti. Koeficijenti su dijadski razlomci, tacni i u float
+    const char* borderModes[] = { "zero", "replicate", "reflect101", "wrap" };
+    const Size imageSizes[] = { Size(1, 1), Size(3, 2), Size(4, 5), Size(23, 17), Size(64, 48) };
+    std::string imagePath = prefix + "_ulaz.ppm";
+    for (Size imageSize : imageSizes) {
+        Mat image = randomImage(imageSize.height, imageSize.width, generator);
+        imwrite(imagePath, image);
+        for (int kernelSize = 3; kernelSize <= 7; kernelSize += 2) {
+            Mat boxKernel(kernelSize, kernelSize, CV_64F, Scalar(1.0 / 64));
+            Mat rankOneKernel(kernelSize, kernelSize, CV_64F);
+            Mat generalKernel(kernelSize, kernelSize, CV_64F);
+            std::vector<int> columnFactors(kernelSize), rowFactors(kernelSize);
+            for (int i = 0; i < kernelSize; i++) {
+                columnFactors[i] = (int)(generator() % 5) - 1;
+                rowFactors[i] = (int)(generator() % 5) - 1;
+            }
+            for (int u = 0; u < kernelSize; u++) {
+                for (int v = 0; v < kernelSize; v++) {
+                    rankOneKernel.at<double>(u, v) = columnFactors[u] * rowFactors[v] / 16.0;
+                    generalKernel.at<double>(u, v) = ((int)(generator() % 9) - 3) / 32.0;
+                }
+            }
+            const std::pair<const char*, Mat> kernels[] = { { "box", boxKernel }, { "rang 1", rankOneKernel }, { "opsti", generalKernel } };
+
+            for (const std::pair<const char*, Mat>& kernel : kernels) {
+                for (const char* borderMode : borderModes) {
+                    std::string border = std::string("--border=") + borderMode;
+                    RegressionArguments engineArguments(regressionArguments(program, imagePath, prefix + "_izlaz.ppm", kernel.second, { border, "--storage=f64", "--accumulate=f64" }));
+                    std::string label = std::to_string(imageSize.width) + " x " + std::to_string(imageSize.height) + ", kernel " + kernel.first + " " + std::to_string(kernelSize) + " x " + std::to_string(kernelSize) + ", " + borderMode;
+
+                    Convolution_NoOpt reference(engineArguments.count(), engineArguments.data());
+                    reference.setInputImage(image);
+                    Mat expected = reference.performConvolution().clone();
+
+                    check("separable, " + label, regressionError<Convolution_Separable>(engineArguments, image, expected));
+                    check("fft, " + label, regressionError<Convolution_FFT>(engineArguments, image, expected));
+                    check("planar, " + label, regressionError<Convolution_Planar>(engineArguments, image, expected));
+                    check("fixedpoint, " + label, regressionError<Convolution_FixedPoint>(engineArguments, image, expected));
+                    check("fixedsize, " + label, regressionError<Convolution_FixedSize>(engineArguments, image, expected));
+                    check("fused, " + label, regressionError<Convolution_Fused>(engineArguments, image, expected));
+                    check("strided, " + label, regressionError<Convolution_Strided>(engineArguments, image, expected));
+                    check("mixed, " + label, regressionError<Convolution_MixedPrecision>(engineArguments, image, expected));
+                    check("winograd, " + label, regressionError<Convolution_Winograd>(engineArguments, image, expected));
+                    check("box, " + label, regressionError<Convolution_Box>(engineArguments, image, expected));
+                    check("incremental, " + label, regressionError<Convolution_Incremental>(engineArguments, image, expected));
+
+                    // Streaming cita ulaz iz fajla i odbija wrap
+                    if (std::string(borderMode) != "wrap") {
+                        Convolution_Streaming streaming(engineArguments.count(), engineArguments.data());
+                        double error = norm(streaming.performConvolution(), expected, NORM_INF);
+                        check("streaming, " + label, std::max(error, norm(streaming.performParallelConvolution(), expected, NORM_INF)));
+                    }
+                    else {
+                        bool rejected = false;
+                        try {
+                            Convolution_Streaming streaming(engineArguments.count(), engineArguments.data());
+                        }
+                        catch (const std::invalid_argument&) {
+                            rejected = true;
+                        }
+                        check("streaming odbija wrap, " + label, rejected ? 0 : INFINITY);
+                    }
+
+                    // Inkrementalno: izmijenjen pravougaonik mora dati isto sto i puna konvolucija izmijenjene slike
+                    Mat edited = image.clone();
+                    Convolution_Incremental incremental(engineArguments.count(), engineArguments.data());
+                    incremental.setInputImage(edited);
+                    incremental.performConvolution();
+                    Rect change(edited.cols / 3, edited.rows / 3, std::max(edited.cols / 4, 1), std::max(edited.rows / 4, 1));
+                    randomImage(change.height, change.width, generator).copyTo(edited(change));
+                    Mat incrementalResult = incremental.performIncrementalConvolution({ change }, true).clone();
+                    reference.setInputImage(edited);
+                    check("incremental izmjena, " + label, norm(incrementalResult, reference.performConvolution(), NORM_INF));
+                }
+            }
+        }
+    }
+    std::remove(imagePath.c_str());
+
+    // Paket i okviri kroz iste fabrike kao --batch i --video. Vise slika iste velicine otkriva
+    // varijante koje vracaju bafer koji sljedeca slika prepisuje (a koder ga jos cita)
+    const int imageCount = 4;
+    std::vector<Mat> images;
+    std::string listPath = prefix + "_paket.txt";
+    std::string batchDirectory = prefix + "_paket";
+    std::ofstream list(listPath);
+    for (int i = 0; i < imageCount; i++) {
+        images.push_back(randomImage(48, 64, generator));
+        std::string path = prefix + "_paket_" + std::to_string(i) + ".ppm";
+        imwrite(path, images[i]);
+        list << path << "\n";
+    }
+    list.close();
+    std::string framePattern = prefix + "_okvir_%03d.png";
+    std::string resultPattern = prefix + "_rezultat_%03d.png";
+    std::vector<char> framePath(framePattern.size() + 16);
+    for (int i = 0; i < imageCount; i++) {
+        snprintf(framePath.data(), framePath.size(), framePattern.c_str(), i);
+        imwrite(framePath.data(), images[i]);
+    }
+
+    // Sobel 5 x 5 (dijagonalne ivice)
+    double sobelTaps[25] = {
+        1, 2, 0, -2, -1,
+        2, 4, 0, -4, -2,
+        0, 0, 0, 0, 0,
+        -2, -4, 0, 4, 2,
+        -1, -2, 0, 2, 1
+    };
+    Mat kernel = Mat(5, 5, CV_64F, sobelTaps) * (1.0 / 16);
+    const char* pipelineEngines[] = { "fixedsize", "planar", "fixedpoint", "separable", "fft", "fused", "gaussian" };
+    for (const char* engine : pipelineEngines) {
+        RegressionArguments engineArguments(regressionArguments(program, listPath, batchDirectory, kernel, { std::string("--engine=") + engine, "--border=reflect101", "--sigma=2" }));
+        // Referenca je NoOpt, a za rekurzivni Gaus njegov sekvencijalni rezultat
+        std::vector<Mat> expected;
+        Convolution_NoOpt reference(engineArguments.count(), engineArguments.data());
+        Convolution_RecursiveGaussian gaussian(engineArguments.count(), engineArguments.data());
+        for (const Mat& image : images) {
+            if (std::string(engine) == "gaussian") {
+                gaussian.setInputImage(image);
+                expected.push_back(gaussian.performConvolution().clone());
+            }
+            else {
+                reference.setInputImage(image);
+                expected.push_back(reference.performConvolution().clone());
+            }
+        }
+
+        std::function<void(const Mat&, Mat&)> convolution = selectBatchConvolution(engineArguments.count(), engineArguments.data());
+        BatchPipeline batch(2, 2, 2);
+        batch.run(BatchPipeline::listInputs(listPath), batchDirectory, allocatingConvolution(convolution));
+        for (int i = 0; i < imageCount; i++) {
+            Mat result = imread(batchDirectory + "/" + baseFileName(prefix) + "_paket_" + std::to_string(i) + ".ppm");
+            check(std::string("paket ") + engine + ", slika " + std::to_string(i), result.size() == expected[i].size() ? norm(result, expected[i], NORM_INF) : INFINITY);
+        }
+
+        FramePipeline frames(2, "MJPG");
+        frames.run(framePattern, resultPattern, convolution, 0);
+        for (int i = 0; i < imageCount; i++) {
+            snprintf(framePath.data(), framePath.size(), resultPattern.c_str(), i);
+            Mat result = imread(framePath.data());
+            check(std::string("okviri ") + engine + ", okvir " + std::to_string(i), result.size() == expected[i].size() ? norm(result, expected[i], NORM_INF) : INFINITY);
+            std::remove(framePath.data());
+        }
+    }
+    for (int i = 0; i < imageCount; i++) {
+        std::remove((prefix + "_paket_" + std::to_string(i) + ".ppm").c_str());
+        std::remove((batchDirectory + "/" + baseFileName(prefix) + "_paket_" + std::to_string(i) + ".ppm").c_str());
+        snprintf(framePath.data(), framePath.size(), framePattern.c_str(), i);
+        std::remove(framePath.data());
+    }
+    std::remove(listPath.c_str());
+
+    log = "Regresija: " + std::to_string(checks) + " provjera, " + std::to_string(failures) + " gresaka (dozvoljeno odstupanje " + std::to_string((int)tolerance) + " nivo)" + log;
+    std::cout << log << std::endl;
+
+    std::ofstream outFile("rezultati_regresija.txt");
+    outFile << log << "\n";
+
+    return failures == 0 ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,669 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <memory>
+#include <map>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include "Convolution_NoOpt.h"
+#include "Convolution_O1Opt.h"
+#include "Convolution_O2Opt.h"
+#include "Convolution_OXOpt.h"
+#include "ConvolutionUsingIntrinsicFunctions.h"
+#include "ConvolutionWorkspace.h"
+#include "Convolution_Separable.h"
+#include "Convolution_FFT.h"
+#include "Convolution_Planar.h"
+#include "Convolution_FixedPoint.h"
+#include "Convolution_FixedSize.h"
+#include "Convolution_Fused.h"
+#include "Convolution_Strided.h"
+#include "Convolution_MixedPrecision.h"
+#include "Convolution_Winograd.h"
+#include "Convolution_Box.h"
+#include "Convolution_Incremental.h"
+#include "Convolution_RecursiveGaussian.h"
+#include "Convolution_Streaming.h"
+#include "BenchmarkStatistics.h"
+#include "CacheInfo.h"
+#include "CpuFeatures.h"
+#include "NumaPlacement.h"
+#include "PerformanceCounters.h"
+#include "Roofline.h"
+
+// Jedna varijanta spremna za mjerenje: objekat je napravljen za zadati kernel, a slika se postavlja prije mjerenja
+struct BenchmarkEngine {
+    std::string name;
+    std::function<void(const Mat&)> setImage;
+    std::function<Mat()> sequential;
+    std::function<Mat()> parallel;
+    // false kada varijanta ne racuna zadati kernel (gaussian), pa se ne poredi sa referencom
+    bool usesKernel = true;
+};
+
+struct BenchmarkRecord {
+    std::string engine;
+    std::string mode;
+    int width;
+    int height;
+    int kernelSize;
+    TimingStatistics statistics;
+    double megapixelsPerSecond;
+    double gflops;
+    // Najvece odstupanje izlaza od direktne konvolucije u nivoima (-1 ako se ne poredi)
+    double maxError;
+    // Brojaci po jednom izvrsavanju (-1 ako nisu dostupni) i polozaj na roofline modelu
+    bool hasCounters;
+    long long cycles;
+    long long instructions;
+    long long l1Misses;
+    long long lastLevelMisses;
+    long long floatingPointOperations;
+    bool measuredFloatingPoint;
+    RooflinePoint roofline;
+};
+
+std::map<std::string, std::string> readOptions(int argc, char* argv[]);
+std::vector<int> readList(const std::string& text);
+template <class Convolution>
+BenchmarkEngine makeEngine(const std::string& name, std::vector<char*>& engineArguments);
+template <class Convolution>
+BenchmarkEngine makePlacedEngine(const std::string& name, std::vector<char*>& engineArguments, NumaPlacement placement, HugePages hugePages);
+BenchmarkEngine makeWinogradEngine(const std::string& name, std::vector<char*>& engineArguments, int tileSize);
+BenchmarkEngine makeStreamingEngine(const std::string& name, std::vector<char*>& engineArguments);
+bool usesWorkspace(const std::string& name);
+bool createEngine(const std::string& name, std::vector<char*>& engineArguments, NumaPlacement placement, HugePages hugePages, BenchmarkEngine& engine);
+Mat makeSyntheticImage(long long pixels);
+std::vector<std::string> makeKernelArguments(int kernelSize);
+void measureCounters(PerformanceCounters& counters, const std::function<Mat()>& convolution, int iterations, double analyticFlops, const RooflinePeaks& peaks, BenchmarkRecord& record);
+std::string describeCounters(const BenchmarkRecord& record, long long pixels);
+std::string formatNumber(double value);
+std::string formatCounter(long long value);
+void writeCsv(const std::string& path, const std::vector<BenchmarkRecord>& records);
+void writeJson(const std::string& path, const std::vector<BenchmarkRecord>& records, int warmUp, int repetitions, const RooflinePeaks* peaks);
+
+// Mjerenje nad sintetickim slikama 10^N piksela (4:3) i kvadratnim kernelima, bez ulaznih fajlova:
+//   ConvolutionBenchmark [--sizes=3,4,5,6,7] [--kernels=3,5,7] [--engines=all|planar,fft,...]
+//                        [--mode=both|seq|par] [--warmup=3] [--repetitions=30] [--budget=60]
+//                        [--json=rezultati_benchmark.json] [--csv=rezultati_benchmark.csv] [--counters=on|off]
+//                        [--numa=aware|naive|both] [--hugepages=off|transparent|explicit] [--affinity=none|compact|scatter]
+//                        [--accuracy=on|off]
+// Uz vrijeme se za svaku varijantu mjere hardverski brojaci (IPC, promasaji kesa, FP operacije) i
+// racuna polozaj na roofline modelu; bez brojaca (npr. van Linuxa) ostaje samo vrijeme.
+// --numa=both mjeri varijante sa radnim prostorom (noopt ... intrinsics) dva puta, sa baferima
+// koje prvi upisuje pozivajuca nit (naive) i niti koje ih racunaju (aware), kao noopt-naive i noopt-aware.
+// --accuracy=on uz svako mjerenje ispisuje najvece odstupanje izlaza od direktne konvolucije u double
+// (oxopt, paralelno) za istu sliku i kernel, npr. za winograd2/winograd4 i varijante sa manjom preciznoscu.
+// streaming cita sliku iz privremenog PPM fajla u tekucem direktorijumu, a gaussian (--sigma) ne racuna
+// zadati kernel, pa se ne poredi sa referencom.
+// Ostale opcije (npr. --isa=avx2, --fixed=16, --storage=bf16) prosljedjuju se varijantama.
+int main(int argc, char* argv[]) {
+
+    std::map<std::string, std::string> options = readOptions(argc, argv);
+    auto option = [&](const std::string& name, const std::string& defaultValue) {
+        auto found = options.find(name);
+        return found == options.end() ? defaultValue : found->second;
+    };
+
+    std::vector<int> sizes = readList(option("sizes", "3,4,5,6,7"));
+    std::vector<int> kernelSizes = readList(option("kernels", "3,5,7"));
+    std::string engineList = option("engines", "all");
+    std::string mode = option("mode", "both");
+    int warmUp = std::stoi(option("warmup", "3"));
+    int repetitions = std::stoi(option("repetitions", "30"));
+    double budget = std::stod(option("budget", "60"));
+    std::string jsonPath = option("json", "rezultati_benchmark.json");
+    std::string csvPath = option("csv", "rezultati_benchmark.csv");
+    std::string numa = option("numa", "aware");
+    HugePages hugePages = parseHugePages(option("hugepages", "off"));
+    std::vector<NumaPlacement> placements;
+    if (numa == "both") {
+        placements = { NumaNaive, NumaAware };
+    }
+    else {
+        placements = { parseNumaPlacement(numa) };
+    }
+    setAffinityPolicy(selectAffinityPolicy(option("affinity", "")));
+    bool accuracy = option("accuracy", "on") != "off";
+
+    // Brojaci se otvaraju prije prvog paralelnog poziva da bi ih naslijedile i niti skupa
+    std::unique_ptr<PerformanceCounters> counters;
+    if (option("counters", "on") != "off") {
+        counters.reset(new PerformanceCounters());
+        if (!counters->isAvailable()) {
+            std::cout << "Hardverski brojaci nisu dostupni, prikazuje se samo vrijeme" << std::endl;
+            counters.reset();
+        }
+    }
+
+    if (repetitions < 1 || warmUp < 0) {
+        std::cerr << "Broj ponavljanja mora biti bar 1" << std::endl;
+        return 1;
+    }
+
+    const char* allEngines[] = { "noopt", "o1opt", "o2opt", "oxopt", "intrinsics", "separable", "fft", "planar", "fixedpoint", "fixedsize", "fused", "strided", "mixed", "winograd2", "winograd4", "box", "incremental", "gaussian", "streaming" };
+    std::vector<std::string> engineNames;
+    if (engineList == "all") {
+        engineNames.assign(std::begin(allEngines), std::end(allEngines));
+    }
+    else {
+        std::stringstream stream(engineList);
+        std::string name;
+        while (std::getline(stream, name, ',')) {
+            engineNames.push_back(name);
+        }
+    }
+
+    // Opcije benchmarka se ne prosljedjuju varijantama; ostale idu iza kernela
+    const char* ownOptions[] = { "--sizes", "--kernels", "--engines", "--mode", "--warmup", "--repetitions", "--budget", "--json", "--csv", "--counters", "--numa", "--hugepages", "--affinity", "--accuracy" };
+    std::vector<std::string> forwardedOptions;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool own = false;
+        for (const char* ownOption : ownOptions) {
+            own = own || argument.compare(0, strlen(ownOption), ownOption) == 0;
+        }
+        if (!own) {
+            forwardedOptions.push_back(argument);
+        }
+    }
+
+    // Za svaki kernel po jedan objekat svake varijante (pretprocesiranje kernela se ne mjeri)
+    std::vector<std::vector<BenchmarkEngine>> engines(kernelSizes.size());
+    std::vector<BenchmarkEngine> references(kernelSizes.size());
+    std::vector<std::vector<std::string>> engineArgumentStorage(kernelSizes.size());
+    for (size_t k = 0; k < kernelSizes.size(); k++) {
+        std::vector<std::string>& storage = engineArgumentStorage[k];
+        storage.push_back(argv[0]);
+        storage.push_back("sinteticka_slika");
+        storage.push_back("sinteticki_rezultat");
+        std::vector<std::string> kernelArguments = makeKernelArguments(kernelSizes[k]);
+        storage.insert(storage.end(), kernelArguments.begin(), kernelArguments.end());
+        storage.insert(storage.end(), forwardedOptions.begin(), forwardedOptions.end());
+
+        std::vector<char*> engineArguments;
+        for (std::string& argument : storage) {
+            engineArguments.push_back(&argument[0]);
+        }
+
+        if (accuracy && !createEngine("oxopt", engineArguments, placements.back(), hugePages, references[k])) {
+            accuracy = false;
+        }
+
+        for (const std::string& name : engineNames) {
+            // Smjestanje bafera se poredi samo kod varijanti sa radnim prostorom
+            bool compare = placements.size() > 1 && usesWorkspace(name);
+            for (size_t p = 0; p < (compare ? placements.size() : 1); p++) {
+                BenchmarkEngine engine;
+                if (createEngine(name, engineArguments, placements[p], hugePages, engine)) {
+                    if (compare) {
+                        engine.name += "-" + getNumaPlacementName(placements[p]);
+                    }
+                    engines[k].push_back(engine);
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> nodes = detectNumaNodes();
+    std::cout << "NUMA cvorova: " << nodes.size();
+    for (size_t n = 0; n < nodes.size(); n++) {
+        std::cout << (n == 0 ? " (" : ", ") << nodes[n].size() << " procesora";
+    }
+    std::cout << "), smjestanje: " << numa << ", vezivanje niti: " << getAffinityPolicyName(getAffinityPolicy())
+        << ", velike stranice: " << getHugePagesName(hugePages) << std::endl;
+
+    std::vector<BenchmarkRecord> records;
+    std::map<std::string, double> secondsPerPixel;
+    const char* modes[2] = { "seq", "par" };
+
+    RooflinePeaks peaks[2];
+    if (counters) {
+        for (int m = 0; m < 2; m++) {
+            peaks[m] = estimateRooflinePeaks(m == 1);
+            std::cout << "Roofline " << modes[m] << " (" << peaks[m].threads << " niti): vrh " << formatNumber(peaks[m].gflops) << " GFLOP/s ("
+                << formatNumber(peaks[m].frequency / 1e9) << " GHz, " << getIsaLevelName(detectIsaLevel()) << "), memorija " << formatNumber(peaks[m].bandwidth)
+                << " GB/s, tacka preloma " << formatNumber(peaks[m].gflops / peaks[m].bandwidth) << " FLOP/B" << std::endl;
+        }
+    }
+
+    for (int exponent : sizes) {
+        long long pixels = (long long)llround(pow(10.0, exponent));
+        Mat image;
+        try {
+            image = makeSyntheticImage(pixels);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Slika 10^" << exponent << " piksela nije napravljena: " << e.what() << std::endl;
+            continue;
+        }
+
+        for (size_t k = 0; k < kernelSizes.size(); k++) {
+            int kernelSize = kernelSizes[k];
+
+            // Referenca za odstupanje: direktna konvolucija iste slike i kernela
+            Mat reference;
+            if (accuracy) {
+                references[k].setImage(image);
+                reference = references[k].parallel().clone();
+                references[k].setImage(Mat());
+            }
+
+            for (BenchmarkEngine& engine : engines[k]) {
+                engine.setImage(image);
+                for (int m = 0; m < 2; m++) {
+                    if (mode != "both" && mode != modes[m]) {
+                        continue;
+                    }
+                    std::string key = engine.name + "/" + modes[m] + "/" + std::to_string(kernelSize);
+                    std::string label = engine.name + " " + modes[m] + " " + std::to_string(image.cols) + "x" + std::to_string(image.rows) + " k" + std::to_string(kernelSize);
+
+                    // Procjena na osnovu manje slike: preskace se ako bi mjerenje trajalo duze od budzeta
+                    auto previous = secondsPerPixel.find(key);
+                    if (previous != secondsPerPixel.end()) {
+                        double estimate = previous->second * image.total() * (warmUp + repetitions);
+                        if (estimate > budget) {
+                            std::cout << label << ": preskoceno (procjena " << formatNumber(estimate) << " s > " << formatNumber(budget) << " s)" << std::endl;
+                            continue;
+                        }
+                    }
+
+                    BenchmarkRecord record;
+                    std::function<Mat()> convolution = m == 0 ? engine.sequential : engine.parallel;
+                    try {
+                        record.statistics = summarizeTimings(collectTimings(convolution, warmUp, repetitions));
+                    }
+                    catch (const std::exception& e) {
+                        std::cout << label << ": greska (" << e.what() << ")" << std::endl;
+                        continue;
+                    }
+
+                    // GFLOP/s po direktnoj formuli (K*K mnozenja i sabiranja po kanalu), i za FFT/separabilne varijante
+                    double median = record.statistics.median;
+                    record.engine = engine.name;
+                    record.mode = modes[m];
+                    record.width = image.cols;
+                    record.height = image.rows;
+                    record.kernelSize = kernelSize;
+                    record.megapixelsPerSecond = image.total() / median / 1e6;
+                    record.gflops = 2.0 * kernelSize * kernelSize * 3 * image.total() / median / 1e9;
+                    record.maxError = -1;
+                    if (!reference.empty() && engine.usesKernel) {
+                        // Varijante sa drugacijom velicinom izlaza (npr. strided sa korakom) se ne porede
+                        Mat output = convolution();
+                        if (output.size() == reference.size() && output.type() == reference.type()) {
+                            record.maxError = norm(output, reference, NORM_INF);
+                        }
+                    }
+                    record.hasCounters = false;
+                    if (counters) {
+                        // Posebna izvrsavanja sa ukljucenim brojacima, da ne uticu na raspodjelu vremena
+                        measureCounters(*counters, convolution, std::min(repetitions, 5), 2.0 * kernelSize * kernelSize * 3 * image.total(), peaks[m], record);
+                    }
+                    records.push_back(record);
+                    secondsPerPixel[key] = median / image.total();
+
+                    std::cout << label << ": min " << formatNumber(record.statistics.min) << " s, medijana " << formatNumber(median)
+                        << " s, p95 " << formatNumber(record.statistics.p95) << " s, p99 " << formatNumber(record.statistics.p99)
+                        << " s, " << formatNumber(record.megapixelsPerSecond) << " MP/s, " << formatNumber(record.gflops) << " GFLOP/s";
+                    if (record.maxError >= 0) {
+                        std::cout << ", odstupanje " << formatNumber(record.maxError) << " nivoa";
+                    }
+                    std::cout << std::endl;
+                    if (record.hasCounters) {
+                        std::cout << "    " << describeCounters(record, (long long)image.total()) << std::endl;
+                    }
+                }
+                engine.setImage(Mat());
+            }
+        }
+    }
+
+    writeCsv(csvPath, records);
+    writeJson(jsonPath, records, warmUp, repetitions, counters ? peaks : nullptr);
+    std::cout << "Rezultati: " << jsonPath << ", " << csvPath << std::endl;
+
+    return 0;
+}
+
+std::map<std::string, std::string> readOptions(int argc, char* argv[]) {
+    std::map<std::string, std::string> options;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument.size() > 2 && argument.compare(0, 2, "--") == 0) {
+            size_t equalsPosition = argument.find('=');
+            if (equalsPosition == std::string::npos) {
+                options[argument.substr(2)] = "";
+            }
+            else {
+                options[argument.substr(2, equalsPosition - 2)] = argument.substr(equalsPosition + 1);
+            }
+        }
+    }
+    return options;
+}
+
+std::vector<int> readList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string value;
+    while (std::getline(stream, value, ',')) {
+        values.push_back(std::stoi(value));
+    }
+    return values;
+}
+
+template <class Convolution>
+BenchmarkEngine makeEngine(const std::string& name, std::vector<char*>& engineArguments) {
+    std::shared_ptr<Convolution> convolution = std::make_shared<Convolution>((int)engineArguments.size(), engineArguments.data());
+    BenchmarkEngine engine;
+    engine.name = name;
+    engine.setImage = [convolution](const Mat& image) { convolution->setInputImage(image); };
+    engine.sequential = [convolution]() { return convolution->performConvolution(); };
+    engine.parallel = [convolution]() { return convolution->performParallelConvolution(); };
+    return engine;
+}
+
+template <class Convolution>
+BenchmarkEngine makePlacedEngine(const std::string& name, std::vector<char*>& engineArguments, NumaPlacement placement, HugePages hugePages) {
+    std::shared_ptr<Convolution> convolution = std::make_shared<Convolution>((int)engineArguments.size(), engineArguments.data());
+    convolution->setWorkspace(std::make_shared<ConvolutionWorkspace>(placement, hugePages));
+    BenchmarkEngine engine;
+    engine.name = name;
+    engine.setImage = [convolution](const Mat& image) { convolution->setInputImage(image); };
+    engine.sequential = [convolution]() { return convolution->performConvolution(); };
+    engine.parallel = [convolution]() { return convolution->performParallelConvolution(); };
+    return engine;
+}
+
+BenchmarkEngine makeWinogradEngine(const std::string& name, std::vector<char*>& engineArguments, int tileSize) {
+    std::shared_ptr<Convolution_Winograd> convolution = std::make_shared<Convolution_Winograd>((int)engineArguments.size(), engineArguments.data());
+    convolution->setTileSize(tileSize);
+    BenchmarkEngine engine;
+    engine.name = name;
+    engine.setImage = [convolution](const Mat& image) { convolution->setInputImage(image); };
+    engine.sequential = [convolution]() { return convolution->performConvolution(); };
+    engine.parallel = [convolution]() { return convolution->performParallelConvolution(); };
+    return engine;
+}
+
+BenchmarkEngine makeStreamingEngine(const std::string& name, std::vector<char*>& engineArguments) {
+    // Tok u pojasevima cita ulaz iz fajla, pa setImage upisuje sliku u privremeni PPM i pravi objekat
+    // za njega; vrijeme ukljucuje citanje fajla, kao i pri stvarnoj upotrebi. Fajl se brise sa varijantom.
+    std::shared_ptr<std::string> path(new std::string("benchmark_streaming_" + name + ".ppm"), [](std::string* file) {
+        std::remove(file->c_str());
+        delete file;
+    });
+    std::shared_ptr<std::vector<std::string>> arguments = std::make_shared<std::vector<std::string>>(engineArguments.begin(), engineArguments.end());
+    (*arguments)[1] = *path;
+    std::shared_ptr<std::shared_ptr<Convolution_Streaming>> convolution = std::make_shared<std::shared_ptr<Convolution_Streaming>>();
+    auto setImage = [path, arguments, convolution](const Mat& image) {
+        // Prazna slika samo oslobadja objekat
+        convolution->reset();
+        if (image.empty()) {
+            return;
+        }
+        imwrite(*path, image);
+        std::vector<char*> argumentPointers;
+        for (std::string& argument : *arguments) {
+            argumentPointers.push_back(&argument[0]);
+        }
+        *convolution = std::make_shared<Convolution_Streaming>((int)argumentPointers.size(), argumentPointers.data());
+    };
+    // Opcije (npr. --border=wrap, --memory) provjeravaju se odmah, nad slikom od jednog piksela
+    setImage(Mat(1, 1, CV_8UC3, Scalar(0, 0, 0)));
+
+    BenchmarkEngine engine;
+    engine.name = name;
+    engine.setImage = setImage;
+    engine.sequential = [convolution]() { return (*convolution)->performConvolution(); };
+    engine.parallel = [convolution]() { return (*convolution)->performParallelConvolution(); };
+    return engine;
+}
+
+// Varijante ciji baferi su u radnom prostoru (ConvolutionWorkspace), pa na njih utice --numa
+bool usesWorkspace(const std::string& name) {
+    return name == "noopt" || name == "o1opt" || name == "o2opt" || name == "oxopt" || name == "intrinsics";
+}
+
+bool createEngine(const std::string& name, std::vector<char*>& engineArguments, NumaPlacement placement, HugePages hugePages, BenchmarkEngine& engine) {
+    try {
+        if (name == "noopt") {
+            engine = makePlacedEngine<Convolution_NoOpt>(name, engineArguments, placement, hugePages);
+        }
+        else if (name == "o1opt") {
+            engine = makePlacedEngine<Convolution_O1Opt>(name, engineArguments, placement, hugePages);
+        }
+        else if (name == "o2opt") {
+            engine = makePlacedEngine<Convolution_O2Opt>(name, engineArguments, placement, hugePages);
+        }
+        else if (name == "oxopt") {
+            engine = makePlacedEngine<Convolution_OXOpt>(name, engineArguments, placement, hugePages);
+        }
+        else if (name == "intrinsics") {
+            engine = makePlacedEngine<ConvolutionUsingIntrinsicFunctions>(name, engineArguments, placement, hugePages);
+        }
+        else if (name == "separable") {
+            engine = makeEngine<Convolution_Separable>(name, engineArguments);
+        }
+        else if (name == "fft") {
+            engine = makeEngine<Convolution_FFT>(name, engineArguments);
+        }
+        else if (name == "planar") {
+            engine = makeEngine<Convolution_Planar>(name, engineArguments);
+        }
+        else if (name == "fixedpoint") {
+            engine = makeEngine<Convolution_FixedPoint>(name, engineArguments);
+        }
+        else if (name == "fixedsize") {
+            engine = makeEngine<Convolution_FixedSize>(name, engineArguments);
+        }
+        else if (name == "fused") {
+            engine = makeEngine<Convolution_Fused>(name, engineArguments);
+        }
+        else if (name == "strided") {
+            engine = makeEngine<Convolution_Strided>(name, engineArguments);
+        }
+        else if (name == "mixed") {
+            engine = makeEngine<Convolution_MixedPrecision>(name, engineArguments);
+        }
+        else if (name == "winograd2" || name == "winograd4") {
+            engine = makeWinogradEngine(name, engineArguments, name == "winograd2" ? 2 : 4);
+        }
+        else if (name == "box") {
+            engine = makeEngine<Convolution_Box>(name, engineArguments);
+        }
+        else if (name == "incremental") {
+            engine = makeEngine<Convolution_Incremental>(name, engineArguments);
+        }
+        else if (name == "gaussian") {
+            engine = makeEngine<Convolution_RecursiveGaussian>(name, engineArguments);
+            engine.usesKernel = false;
+        }
+        else if (name == "streaming") {
+            engine = makeStreamingEngine(name, engineArguments);
+        }
+        else {
+            std::cerr << "Nepoznata varijanta: " << name << std::endl;
+            return false;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << name << ": " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Mat makeSyntheticImage(long long pixels) {
+    // Odnos stranica 4:3; slucajni sadrzaj sa fiksnim sjemenom da bi mjerenja bila ponovljiva
+    int cols = (int)ceil(sqrt(pixels * 4.0 / 3.0));
+    int rows = (int)((pixels + cols - 1) / cols);
+    Mat image(rows, cols, CV_8UC3);
+    RNG rng(12345);
+    rng.fill(image, RNG::UNIFORM, Scalar::all(0), Scalar::all(256));
+    return image;
+}
+
+std::vector<std::string> makeKernelArguments(int kernelSize) {
+    // Koeficijenti u [-1, 1] sa fiksnim sjemenom, normalizovani da zbir apsolutnih vrijednosti bude 1
+    RNG rng(kernelSize);
+    std::vector<double> values(kernelSize * kernelSize);
+    double absoluteSum = 0;
+    for (double& value : values) {
+        value = rng.uniform(-1.0, 1.0);
+        absoluteSum += fabs(value);
+    }
+
+    std::vector<std::string> arguments;
+    for (double value : values) {
+        std::ostringstream stream;
+        stream << std::setprecision(17) << value / absoluteSum;
+        arguments.push_back(stream.str());
+    }
+    return arguments;
+}
+
+void measureCounters(PerformanceCounters& counters, const std::function<Mat()>& convolution, int iterations, double analyticFlops, const RooflinePeaks& peaks, BenchmarkRecord& record) {
+    counters.start();
+    double start = omp_get_wtime();
+    for (int i = 0; i < iterations; i++) {
+        convolution();
+    }
+    double seconds = (omp_get_wtime() - start) / iterations;
+    counters.stop();
+
+    auto perRun = [iterations](long long value) { return value < 0 ? -1 : value / iterations; };
+    record.hasCounters = true;
+    record.cycles = perRun(counters.getCycles());
+    record.instructions = perRun(counters.getInstructions());
+    record.l1Misses = perRun(counters.getL1Misses());
+    record.lastLevelMisses = perRun(counters.getLastLevelMisses());
+    record.floatingPointOperations = perRun(counters.getFloatingPointOperations());
+
+    // Bez FP brojaca koristi se direktna formula; promet sa memorijom procjenjuje se kao LLC promasaji x 64 B
+    record.measuredFloatingPoint = record.floatingPointOperations >= 0;
+    double flops = record.measuredFloatingPoint ? (double)record.floatingPointOperations : analyticFlops;
+    double bytes = record.lastLevelMisses >= 0 ? 64.0 * record.lastLevelMisses : 0;
+    record.roofline = placeOnRoofline(flops, bytes, seconds, peaks);
+}
+
+std::string describeCounters(const BenchmarkRecord& record, long long pixels) {
+    std::string text;
+    if (record.cycles > 0 && record.instructions >= 0) {
+        text += "IPC " + formatNumber((double)record.instructions / record.cycles) + ", ";
+    }
+    if (record.l1Misses >= 0) {
+        text += "L1 " + formatNumber((double)record.l1Misses / pixels) + " promasaja/piksel, ";
+    }
+    if (record.lastLevelMisses >= 0) {
+        text += "LLC " + formatNumber((double)record.lastLevelMisses / pixels) + " promasaja/piksel, ";
+        text += "memorija " + formatNumber(record.roofline.bandwidth) + " GB/s, intenzitet " + formatNumber(record.roofline.intensity) + " FLOP/B, ";
+    }
+    text += formatNumber(record.roofline.gflops) + (record.measuredFloatingPoint ? "" : " (formula)") + " od " + formatNumber(record.roofline.attainable) + " GFLOP/s krova";
+    if (record.lastLevelMisses >= 0) {
+        text += record.roofline.memoryBound ? ", memorijski ogranicena" : ", racunski ogranicena";
+    }
+    return text;
+}
+
+std::string formatCounter(long long value) {
+    return value < 0 ? "" : std::to_string(value);
+}
+
+std::string formatNumber(double value) {
+    std::ostringstream stream;
+    stream << std::setprecision(6) << value;
+    return stream.str();
+}
+
+void writeCsv(const std::string& path, const std::vector<BenchmarkRecord>& records) {
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) {
+        std::cerr << "Fajl nije otvoren: " << path << std::endl;
+        return;
+    }
+
+    outFile << "engine,mode,width,height,pixels,kernel,threads,samples,min_s,median_s,p95_s,p99_s,mean_s,stddev_s,megapixels_per_s,gflops,max_error,"
+        << "cycles,instructions,ipc,l1_misses,llc_misses,fp_ops,memory_gb_per_s,flop_per_byte,attainable_gflops,bound\n";
+    for (const BenchmarkRecord& record : records) {
+        const TimingStatistics& s = record.statistics;
+        outFile << record.engine << "," << record.mode << "," << record.width << "," << record.height << ","
+            << (long long)record.width * record.height << "," << record.kernelSize << "," << omp_get_max_threads() << "," << s.samples << ","
+            << formatNumber(s.min) << "," << formatNumber(s.median) << "," << formatNumber(s.p95) << "," << formatNumber(s.p99) << ","
+            << formatNumber(s.mean) << "," << formatNumber(sqrt(s.variance)) << ","
+            << formatNumber(record.megapixelsPerSecond) << "," << formatNumber(record.gflops) << ","
+            << (record.maxError >= 0 ? formatNumber(record.maxError) : "") << ",";
+        if (record.hasCounters) {
+            outFile << formatCounter(record.cycles) << "," << formatCounter(record.instructions) << ","
+                << (record.cycles > 0 && record.instructions >= 0 ? formatNumber((double)record.instructions / record.cycles) : "") << ","
+                << formatCounter(record.l1Misses) << "," << formatCounter(record.lastLevelMisses) << "," << formatCounter(record.floatingPointOperations) << ",";
+            if (record.lastLevelMisses >= 0) {
+                outFile << formatNumber(record.roofline.bandwidth) << "," << formatNumber(record.roofline.intensity) << ","
+                    << formatNumber(record.roofline.attainable) << "," << (record.roofline.memoryBound ? "memory" : "compute") << "\n";
+            }
+            else {
+                outFile << ",,,\n";
+            }
+        }
+        else {
+            outFile << ",,,,,,,,,\n";
+        }
+    }
+}
+
+void writeJson(const std::string& path, const std::vector<BenchmarkRecord>& records, int warmUp, int repetitions, const RooflinePeaks* peaks) {
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) {
+        std::cerr << "Fajl nije otvoren: " << path << std::endl;
+        return;
+    }
+
+    CacheSizes caches = detectCacheSizes();
+    outFile << "{\n";
+    outFile << "  \"threads\": " << omp_get_max_threads() << ",\n";
+    outFile << "  \"isa\": \"" << getIsaLevelName(detectIsaLevel()) << "\",\n";
+    outFile << "  \"cache\": { \"l1\": " << caches.l1 << ", \"l2\": " << caches.l2 << ", \"l3\": " << caches.l3 << " },\n";
+    outFile << "  \"warmup\": " << warmUp << ",\n";
+    outFile << "  \"repetitions\": " << repetitions << ",\n";
+    if (peaks != nullptr) {
+        outFile << "  \"roofline\": {";
+        for (int m = 0; m < 2; m++) {
+            outFile << (m > 0 ? ", " : " ") << "\"" << (m == 0 ? "seq" : "par") << "\": { \"threads\": " << peaks[m].threads
+                << ", \"peak_gflops\": " << formatNumber(peaks[m].gflops) << ", \"memory_gb_per_s\": " << formatNumber(peaks[m].bandwidth) << " }";
+        }
+        outFile << " },\n";
+    }
+    else {
+        outFile << "  \"roofline\": null,\n";
+    }
+    outFile << "  \"results\": [";
+    for (size_t i = 0; i < records.size(); i++) {
+        const BenchmarkRecord& record = records[i];
+        const TimingStatistics& s = record.statistics;
+        outFile << (i > 0 ? ",\n" : "\n");
+        outFile << "    { \"engine\": \"" << record.engine << "\", \"mode\": \"" << record.mode << "\""
+            << ", \"width\": " << record.width << ", \"height\": " << record.height
+            << ", \"pixels\": " << (long long)record.width * record.height << ", \"kernel\": " << record.kernelSize
+            << ", \"min_s\": " << formatNumber(s.min) << ", \"median_s\": " << formatNumber(s.median)
+            << ", \"p95_s\": " << formatNumber(s.p95) << ", \"p99_s\": " << formatNumber(s.p99)
+            << ", \"mean_s\": " << formatNumber(s.mean) << ", \"stddev_s\": " << formatNumber(sqrt(s.variance))
+            << ", \"megapixels_per_s\": " << formatNumber(record.megapixelsPerSecond) << ", \"gflops\": " << formatNumber(record.gflops)
+            << ", \"max_error\": " << (record.maxError >= 0 ? formatNumber(record.maxError) : "null");
+        if (record.hasCounters) {
+            auto counter = [](long long value) { return value < 0 ? std::string("null") : std::to_string(value); };
+            outFile << ", \"counters\": { \"cycles\": " << counter(record.cycles) << ", \"instructions\": " << counter(record.instructions)
+                << ", \"l1_misses\": " << counter(record.l1Misses) << ", \"llc_misses\": " << counter(record.lastLevelMisses)
+                << ", \"fp_ops\": " << counter(record.floatingPointOperations) << " }";
+            if (record.lastLevelMisses >= 0) {
+                outFile << ", \"roofline\": { \"flop_per_byte\": " << formatNumber(record.roofline.intensity) << ", \"gflops\": " << formatNumber(record.roofline.gflops)
+                    << ", \"memory_gb_per_s\": " << formatNumber(record.roofline.bandwidth) << ", \"attainable_gflops\": " << formatNumber(record.roofline.attainable)
+                    << ", \"bound\": \"" << (record.roofline.memoryBound ? "memory" : "compute") << "\" }";
+            }
+        }
+        outFile << " }";
+    }
+    outFile << "\n  ]\n}\n";
+}
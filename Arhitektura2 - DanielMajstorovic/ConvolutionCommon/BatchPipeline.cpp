@@ -0,0 +1,229 @@
+#include "BatchPipeline.h"
+#include "BoundedQueue.h"
+#include <omp.h>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <cctype>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+static bool isDirectory(const String& path)
+{
+	struct stat information;
+	return stat(path.c_str(), &information) == 0 && (information.st_mode & S_IFMT) == S_IFDIR;
+}
+
+static void createDirectory(const String& path)
+{
+	if (isDirectory(path)) {
+		return;
+	}
+	// Prvo roditeljski direktorijumi
+	size_t slashPosition = path.find_last_of("/\\");
+	if (slashPosition != String::npos && slashPosition > 0) {
+		createDirectory(path.substr(0, slashPosition));
+	}
+#ifdef _WIN32
+	_mkdir(path.c_str());
+#else
+	mkdir(path.c_str(), 0755);
+#endif
+	if (!isDirectory(path)) {
+		throw invalid_argument("Izlazni direktorijum " + path + " se ne moze napraviti");
+	}
+}
+
+static bool isImageFile(const String& path)
+{
+	size_t dotPosition = path.find_last_of('.');
+	if (dotPosition == String::npos) {
+		return false;
+	}
+	String extension = path.substr(dotPosition + 1);
+	transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+	const char* extensions[] = { "jpg", "jpeg", "png", "bmp", "ppm", "pgm", "tif", "tiff", "webp" };
+	for (const char* known : extensions) {
+		if (extension == known) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static String fileName(const String& path)
+{
+	size_t slashPosition = path.find_last_of("/\\");
+	return slashPosition == String::npos ? path : path.substr(slashPosition + 1);
+}
+
+BatchPipeline::BatchPipeline(int decoderThreads, int encoderThreads, size_t queueCapacity)
+	: decoderThreads(max(decoderThreads, 1)), encoderThreads(max(encoderThreads, 1)), queueCapacity(max(queueCapacity, (size_t)1))
+{
+}
+
+vector<String> BatchPipeline::listInputs(const String& directoryOrList)
+{
+	vector<String> inputs;
+	if (isDirectory(directoryOrList)) {
+		vector<String> files;
+		glob(directoryOrList + "/*", files, false);
+		for (const String& file : files) {
+			if (isImageFile(file)) {
+				inputs.push_back(file);
+			}
+		}
+	}
+	else {
+		ifstream list(directoryOrList);
+		if (!list.is_open()) {
+			throw invalid_argument("Ulaz " + directoryOrList + " nije ni direktorijum ni lista fajlova");
+		}
+		string line;
+		while (getline(list, line)) {
+			// Windows kraj reda i prazni redovi
+			while (!line.empty() && isspace((unsigned char)line.back())) {
+				line.pop_back();
+			}
+			if (!line.empty()) {
+				inputs.push_back(line);
+			}
+		}
+	}
+	return inputs;
+}
+
+String BatchPipeline::run(const vector<String>& inputPaths, const String& outputDirectory, const function<Mat(const Mat&)>& convolution)
+{
+	// Izlaz nosi samo ime ulaznog fajla, pa dva ulaza sa istim imenom iz razlicitih direktorijuma
+	// (moguce u listi fajlova) bi se prepisala. Odbijaju se prije pocetka obrade. Poredi se bez obzira
+	// na velicinu slova jer ih Windows ne razlikuje.
+	vector<String> outputPaths(inputPaths.size());
+	map<String, String> inputByName;
+	for (size_t i = 0; i < inputPaths.size(); i++) {
+		String name = fileName(inputPaths[i]);
+		outputPaths[i] = outputDirectory + "/" + name;
+		transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)tolower(c); });
+		auto inserted = inputByName.emplace(name, inputPaths[i]);
+		if (!inserted.second) {
+			throw invalid_argument("Ulazi " + inserted.first->second + " i " + inputPaths[i] + " bi upisali isti izlazni fajl " + outputPaths[i]);
+		}
+	}
+	createDirectory(outputDirectory);
+
+	BoundedQueue<BatchImage> decoded(queueCapacity);
+	BoundedQueue<BatchImage> computed(queueCapacity);
+	atomic<size_t> nextInput(0);
+	atomic<int> activeDecoders(decoderThreads);
+	atomic<int> processedImages(0);
+	atomic<int> failedImages(0);
+	mutex timeMutex;
+	mutex logMutex;
+	double decodeTime = 0, computeTime = 0, encodeTime = 0, computeWaitTime = 0;
+
+	double start = omp_get_wtime();
+
+	vector<thread> decoders;
+	for (int t = 0; t < decoderThreads; t++) {
+		decoders.emplace_back([&]() {
+			double busy = 0;
+			for (size_t i = nextInput++; i < inputPaths.size(); i = nextInput++) {
+				double begin = omp_get_wtime();
+				BatchImage item;
+				item.inputPath = inputPaths[i];
+				item.outputPath = outputPaths[i];
+				item.image = imread(item.inputPath);
+				busy += omp_get_wtime() - begin;
+				if (item.image.empty()) {
+					failedImages++;
+					lock_guard<mutex> lock(logMutex);
+					cerr << "Slika " << item.inputPath << " se ne moze ucitati" << endl;
+					continue;
+				}
+				decoded.push(std::move(item));
+			}
+			{
+				lock_guard<mutex> lock(timeMutex);
+				decodeTime += busy;
+			}
+			// Posljednji dekoder zatvara red, pa faza racunanja zna da vise nema ulaza
+			if (--activeDecoders == 0) {
+				decoded.close();
+			}
+		});
+	}
+
+	thread computeThread([&]() {
+		BatchImage item;
+		double waitBegin = omp_get_wtime();
+		while (decoded.pop(item)) {
+			double begin = omp_get_wtime();
+			computeWaitTime += begin - waitBegin;
+			try {
+				item.image = convolution(item.image);
+				computeTime += omp_get_wtime() - begin;
+				computed.push(std::move(item));
+			}
+			catch (const exception& error) {
+				computeTime += omp_get_wtime() - begin;
+				failedImages++;
+				lock_guard<mutex> lock(logMutex);
+				cerr << "Konvolucija slike " << item.inputPath << " nije uspjela: " << error.what() << endl;
+			}
+			waitBegin = omp_get_wtime();
+		}
+		computed.close();
+	});
+
+	vector<thread> encoders;
+	for (int t = 0; t < encoderThreads; t++) {
+		encoders.emplace_back([&]() {
+			double busy = 0;
+			BatchImage item;
+			while (computed.pop(item)) {
+				double begin = omp_get_wtime();
+				bool written = false;
+				try {
+					written = imwrite(item.outputPath, item.image);
+				}
+				catch (const exception&) {
+					written = false;
+				}
+				busy += omp_get_wtime() - begin;
+				if (written) {
+					processedImages++;
+				}
+				else {
+					failedImages++;
+					lock_guard<mutex> lock(logMutex);
+					cerr << "Slika " << item.outputPath << " se ne moze upisati" << endl;
+				}
+			}
+			lock_guard<mutex> lock(timeMutex);
+			encodeTime += busy;
+		});
+	}
+
+	for (thread& decoder : decoders) {
+		decoder.join();
+	}
+	computeThread.join();
+	for (thread& encoder : encoders) {
+		encoder.join();
+	}
+
+	double totalTime = omp_get_wtime() - start;
+	String report = "Obradjeno slika: " + to_string(processedImages.load()) + " (neuspjesno " + to_string(failedImages.load()) + ")";
+	report += "\nUkupno vrijeme: " + to_string(totalTime) + " s, " + to_string(totalTime > 0 ? processedImages.load() / totalTime : 0.0) + " slika/s";
+	report += "\nDekodiranje: " + to_string(decodeTime) + " s (" + to_string(decoderThreads) + " niti), racunanje: " + to_string(computeTime);
+	report += " s, kodiranje: " + to_string(encodeTime) + " s (" + to_string(encoderThreads) + " niti)";
+	report += "\nRacunanje je cekalo na ulaz: " + to_string(computeWaitTime) + " s";
+	return report;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+// Jedna slika na putu kroz cjevovod
+struct BatchImage
+{
+    String inputPath;
+    String outputPath;
+    Mat image;
+};
+
+// Paketna obrada u tri faze povezane redovima ogranicenog kapaciteta: niti za dekodiranje (imread),
+// jedna nit za konvoluciju (koja sama koristi OpenMP) i niti za kodiranje (imwrite). Dok se jedna
+// slika racuna, sljedece se vec dekodiraju a prethodne kodiraju, pa procesor ne ceka na JPEG.
+// Ogranicen kapacitet redova ogranicava i broj dekodiranih slika u memoriji.
+class BatchPipeline
+{
+    int decoderThreads;
+    int encoderThreads;
+    size_t queueCapacity;
+
+public:
+    BatchPipeline(int decoderThreads, int encoderThreads, size_t queueCapacity);
+    // Slike iz direktorijuma (po ekstenziji) ili iz tekstualnog fajla sa jednom putanjom po redu
+    static vector<String> listInputs(const String& directoryOrList);
+    // Obradjuje sve ulaze i vraca izvjestaj (broj slika, propusnost, vrijeme po fazama). Rezultat
+    // convolution se kodira dok se racuna sljedeca slika, pa ne smije biti bafer koji se ponovo koristi.
+    // Izlaz nosi ime ulaznog fajla; ulazi sa istim imenom se odbijaju (invalid_argument) prije obrade.
+    String run(const vector<String>& inputPaths, const String& outputDirectory, const function<Mat(const Mat&)>& convolution);
+};
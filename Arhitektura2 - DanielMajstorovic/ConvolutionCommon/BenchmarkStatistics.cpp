@@ -0,0 +1,57 @@
+#include "BenchmarkStatistics.h"
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+
+vector<double> collectTimings(const function<Mat()>& convolution, int warmUpIterations, int testIterations)
+{
+	// Prethodno pokretanje (zagrijavanje)
+	for (int i = 0; i < warmUpIterations; i++) {
+		convolution();
+	}
+
+	vector<double> times(testIterations);
+	for (int i = 0; i < testIterations; i++) {
+		double start = omp_get_wtime();
+		Mat img = convolution();
+		double end = omp_get_wtime();
+		times[i] = end - start;
+	}
+	return times;
+}
+
+// Najmanja vrijednost od koje je bar udio fraction uzoraka manji ili jednak
+static double percentile(const vector<double>& sorted, double fraction)
+{
+	size_t rank = (size_t)ceil(fraction * sorted.size());
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+TimingStatistics summarizeTimings(vector<double> times)
+{
+	TimingStatistics statistics = { (int)times.size(), 0, 0, 0, 0, 0, 0 };
+	if (times.empty()) {
+		return statistics;
+	}
+
+	sort(times.begin(), times.end());
+	size_t middle = times.size() / 2;
+	statistics.min = times[0];
+	statistics.median = times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+	statistics.p95 = percentile(times, 0.95);
+	statistics.p99 = percentile(times, 0.99);
+
+	double totalTime = 0;
+	for (double time : times) {
+		totalTime += time;
+	}
+	statistics.mean = totalTime / times.size();
+
+	double tmpSum = 0;
+	for (double time : times) {
+		double diff = statistics.mean - time;
+		tmpSum += diff * diff;
+	}
+	statistics.variance = times.size() > 1 ? tmpSum / (times.size() - 1) : 0;
+	return statistics;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+// Statistika izmjerenih vremena (u sekundama); percentili po metodi najblizeg ranga
+struct TimingStatistics
+{
+    int samples;
+    double min;
+    double median;
+    double p95;
+    double p99;
+    double mean;
+    double variance;
+};
+
+// warmUpIterations nemjerenih pa testIterations mjerenih izvrsavanja, svako posebno izmjereno
+vector<double> collectTimings(const function<Mat()>& convolution, int warmUpIterations, int testIterations);
+
+TimingStatistics summarizeTimings(vector<double> times);
@@ -0,0 +1,223 @@
+#include "BorderHandling.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cstring>
+
+BorderMode parseBorderMode(const string& name)
+{
+	if (name == "zero") {
+		return BorderZero;
+	}
+	if (name == "replicate") {
+		return BorderReplicate;
+	}
+	if (name == "reflect101") {
+		return BorderReflect101;
+	}
+	if (name == "wrap") {
+		return BorderWrap;
+	}
+	throw invalid_argument("Opcija --border mora biti zero, replicate, reflect101 ili wrap");
+}
+
+string getBorderModeName(BorderMode mode)
+{
+	switch (mode) {
+	case BorderReplicate: return "replicate";
+	case BorderReflect101: return "reflect101";
+	case BorderWrap: return "wrap";
+	default: return "zero";
+	}
+}
+
+int mapBorderIndex(int index, int length, BorderMode mode)
+{
+	if (index >= 0 && index < length) {
+		return index;
+	}
+	switch (mode) {
+	case BorderReplicate:
+		return index < 0 ? 0 : length - 1;
+	case BorderReflect101:
+		if (length == 1) {
+			return 0;
+		}
+		// Kernel siri od slike moze zahtijevati vise odraza
+		while (index < 0 || index >= length) {
+			index = index < 0 ? -index : 2 * (length - 1) - index;
+		}
+		return index;
+	case BorderWrap:
+		return ((index % length) + length) % length;
+	default:
+		return -1;
+	}
+}
+
+void padImage(const Mat& source, Mat& padded, int top, int bottom, int left, int right, BorderMode mode)
+{
+	if (top < 0 || bottom < 0 || left < 0 || right < 0) {
+		throw invalid_argument("Prosirenje slike ne moze biti negativno");
+	}
+	// Izvor se kopira ako je isti objekat kao odrediste
+	Mat image = source.data == padded.data ? source.clone() : source;
+	padded.create(image.rows + top + bottom, image.cols + left + right, image.type());
+	size_t pixelBytes = image.elemSize();
+	size_t rowBytes = image.cols * pixelBytes;
+
+	vector<int> sourceCols(padded.cols);
+	for (int j = 0; j < padded.cols; j++) {
+		sourceCols[j] = mapBorderIndex(j - left, image.cols, mode);
+	}
+
+	for (int i = 0; i < padded.rows; i++) {
+		int sourceRow = mapBorderIndex(i - top, image.rows, mode);
+		uchar* destination = padded.ptr<uchar>(i);
+		if (sourceRow < 0) {
+			memset(destination, 0, padded.cols * pixelBytes);
+			continue;
+		}
+		const uchar* row = image.ptr<uchar>(sourceRow);
+		for (int j = 0; j < left; j++) {
+			if (sourceCols[j] < 0) {
+				memset(destination + j * pixelBytes, 0, pixelBytes);
+			}
+			else {
+				memcpy(destination + j * pixelBytes, row + sourceCols[j] * pixelBytes, pixelBytes);
+			}
+		}
+		memcpy(destination + left * pixelBytes, row, rowBytes);
+		for (int j = left + image.cols; j < padded.cols; j++) {
+			if (sourceCols[j] < 0) {
+				memset(destination + j * pixelBytes, 0, pixelBytes);
+			}
+			else {
+				memcpy(destination + j * pixelBytes, row + sourceCols[j] * pixelBytes, pixelBytes);
+			}
+		}
+	}
+}
+
+Rect interiorRegion(Size imageSize, Size kernelSize)
+{
+	int halfRows = kernelSize.height / 2;
+	int halfCols = kernelSize.width / 2;
+	int rows = max(imageSize.height - 2 * halfRows, 0);
+	int cols = max(imageSize.width - 2 * halfCols, 0);
+	return Rect(min(halfCols, imageSize.width), min(halfRows, imageSize.height), cols, rows);
+}
+
+// Tabela indeksa izvora za svaki centar i svaki tap: table[center * taps + t]
+static vector<int> buildIndexTable(int length, int taps, BorderMode mode)
+{
+	int half = taps / 2;
+	vector<int> table((size_t)length * taps);
+	for (int center = 0; center < length; center++) {
+		for (int t = 0; t < taps; t++) {
+			table[(size_t)center * taps + t] = mapBorderIndex(center - half + t, length, mode);
+		}
+	}
+	return table;
+}
+
+void convolveBorder(const Mat& source, const Mat& kernel, BorderMode mode, Mat& result, bool parallel)
+{
+	if (source.type() != CV_8UC3) {
+		throw invalid_argument("Ulazna slika mora biti CV_8UC3");
+	}
+
+	Rect interior = interiorRegion(source.size(), kernel.size());
+	vector<int> rowTable = buildIndexTable(source.rows, kernel.rows, mode);
+	vector<int> colTable = buildIndexTable(source.cols, kernel.cols, mode);
+
+	auto convolvePixels = [&](int x, int firstCol, int lastCol) {
+		const int* rowIndices = &rowTable[(size_t)x * kernel.rows];
+		Vec3d* destination = result.ptr<Vec3d>(x);
+		for (int y = firstCol; y < lastCol; y++) {
+			const int* colIndices = &colTable[(size_t)y * kernel.cols];
+			double r = 0, g = 0, b = 0;
+			for (int u = 0; u < kernel.rows; u++) {
+				if (rowIndices[u] < 0) {
+					continue;
+				}
+				const uchar* row = source.ptr<uchar>(rowIndices[u]);
+				const double* kernelRow = kernel.ptr<double>(u);
+				for (int v = 0; v < kernel.cols; v++) {
+					if (colIndices[v] < 0) {
+						continue;
+					}
+					const uchar* pixel = row + 3 * colIndices[v];
+					r += pixel[0] * kernelRow[v];
+					g += pixel[1] * kernelRow[v];
+					b += pixel[2] * kernelRow[v];
+				}
+			}
+			destination[y] = Vec3d(r, g, b);
+		}
+	};
+
+	// Gornji i donji pojas cijelom sirinom, a u redovima unutrasnjosti samo lijeva i desna kolona ivice
+	forEachIndex(source.rows, parallel, [&](int x) {
+		if (x < interior.y || x >= interior.y + interior.height) {
+			convolvePixels(x, 0, source.cols);
+		}
+		else {
+			convolvePixels(x, 0, interior.x);
+			convolvePixels(x, interior.x + interior.width, source.cols);
+		}
+	});
+}
+
+void convolveDirect(const Mat& source, const Mat& kernel, BorderMode mode, Mat& result, bool parallel)
+{
+	if (source.type() != CV_64FC3) {
+		throw invalid_argument("Ulazna slika mora biti CV_64FC3");
+	}
+
+	int rows = source.rows;
+	int cols = source.cols;
+	int kernelRowsSizeHalf = kernel.rows / 2;
+	int kernelColsSizeHalf = kernel.cols / 2;
+
+	result = Mat(rows, cols, CV_64FC3);
+
+	// Indeksi van slike preslikani jednom; sourceRows[x + u + polovina] je izvorni red za tap u
+	vector<int> sourceRows(rows + 2 * kernelRowsSizeHalf);
+	vector<int> sourceCols(cols + 2 * kernelColsSizeHalf);
+	for (int i = 0; i < (int)sourceRows.size(); i++) {
+		sourceRows[i] = mapBorderIndex(i - kernelRowsSizeHalf, rows, mode);
+	}
+	for (int j = 0; j < (int)sourceCols.size(); j++) {
+		sourceCols[j] = mapBorderIndex(j - kernelColsSizeHalf, cols, mode);
+	}
+
+	forEachIndex(rows, parallel, [&](int x) {
+		double* destination = result.ptr<double>(x);
+		for (int y = 0; y < cols; y++) {
+			double r = 0, g = 0, b = 0;
+			for (int u = -kernelRowsSizeHalf; u <= kernelRowsSizeHalf; u++) {
+				int sourceRow = sourceRows[x + u + kernelRowsSizeHalf];
+				if (sourceRow < 0) {
+					continue;
+				}
+				const double* sourcePixels = source.ptr<double>(sourceRow);
+				const double* taps = kernel.ptr<double>(u + kernelRowsSizeHalf);
+				for (int v = -kernelColsSizeHalf; v <= kernelColsSizeHalf; v++) {
+					int sourceCol = sourceCols[y + v + kernelColsSizeHalf];
+					if (sourceCol < 0) {
+						continue;
+					}
+					double weight = taps[v + kernelColsSizeHalf];
+					const double* pixel = sourcePixels + 3 * sourceCol;
+					r += pixel[0] * weight;
+					g += pixel[1] * weight;
+					b += pixel[2] * weight;
+				}
+			}
+			destination[3 * y] = r;
+			destination[3 * y + 1] = g;
+			destination[3 * y + 2] = b;
+		}
+	});
+}
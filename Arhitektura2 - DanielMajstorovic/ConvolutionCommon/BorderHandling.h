@@ -0,0 +1,45 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <string>
+
+using namespace cv;
+using namespace std;
+
+// Nacin prosirenja slike van ivica (--border=zero|replicate|reflect101|wrap):
+//  - BorderZero: pikseli van slike su 0
+//  - BorderReplicate: ponavlja se ivicni piksel (aaa|abcd|ddd)
+//  - BorderReflect101: odraz bez ponavljanja ivicnog piksela (cb|abcd|cb)
+//  - BorderWrap: slika se ponavlja periodicno (cd|abcd|ab)
+enum BorderMode
+{
+    BorderZero,
+    BorderReplicate,
+    BorderReflect101,
+    BorderWrap
+};
+
+BorderMode parseBorderMode(const string& name);
+string getBorderModeName(BorderMode mode);
+
+// Indeks van [0, length) preslikan u sliku prema nacinu prosirenja; -1 kada je piksel nula
+int mapBorderIndex(int index, int length, BorderMode mode);
+
+// Kopija slike bilo kog tipa prosirena za top/bottom/left/right piksela prema nacinu prosirenja
+// (isto preslikavanje kao mapBorderIndex, i kada je prosirenje sire od slike); nule za BorderZero.
+// Koristi se samo gdje vektorska ucitavanja prelaze ivicu reda (Convolution_FixedPoint); ostale
+// varijante preslikavaju indekse bez kopije.
+void padImage(const Mat& source, Mat& padded, int top, int bottom, int left, int right, BorderMode mode);
+
+// Centri kernela za koje cijeli kernel lezi u slici: tu petlja cita izvor bez ikakve provjere ivica
+Rect interiorRegion(Size imageSize, Size kernelSize);
+
+// Racuna sve izlazne piksele van interiorRegion direktno iz CV_8UC3 izvora u CV_64FC3 rezultat.
+// Indeksi redova i kolona van slike preslikavaju se jednom u tabele, pa petlja po tapovima nema
+// grananja po nacinu prosirenja. Tapovi se sabiraju redom po u pa v, kao u gustoj petlji; unutrasnjost
+// sa grupisanim KernelProgram sabira drugim redom, pa se ivica i unutrasnjost razlikuju u zaokruzivanju.
+void convolveBorder(const Mat& source, const Mat& kernel, BorderMode mode, Mat& result, bool parallel);
+
+// Direktna K x K konvolucija CV_64FC3 izvora u novi CV_64FC3 rezultat, za cijelu sliku sa ivicama
+// preslikanim kroz tabele. Rezervni put varijanti (Separable, FFT) za kernele kod kojih njihova
+// transformacija ne donosi ustedu.
+void convolveDirect(const Mat& source, const Mat& kernel, BorderMode mode, Mat& result, bool parallel);
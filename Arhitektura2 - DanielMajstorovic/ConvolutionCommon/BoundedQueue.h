@@ -0,0 +1,55 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+// Red ogranicenog kapaciteta izmedju faza cjevovoda: push ceka dok je red pun, pop ceka dok je
+// prazan. Nakon close() push odbija nove elemente, a pop vraca false kada se red isprazni.
+template <class T>
+class BoundedQueue
+{
+    std::deque<T> items;
+    size_t capacity;
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+public:
+    BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false)
+    {
+    }
+
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]() { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
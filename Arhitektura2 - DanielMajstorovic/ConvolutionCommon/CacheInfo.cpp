@@ -0,0 +1,92 @@
+#include "CacheInfo.h"
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#endif
+
+#ifndef _WIN32
+// Citanje /sys/devices/system/cpu/cpu0/cache/indexN kada sysconf ne zna velicine
+static size_t readSysfsCacheSize(int level, bool dataCache)
+{
+	for (int index = 0; index < 8; index++) {
+		std::string base = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+		std::ifstream levelFile(base + "level");
+		std::ifstream typeFile(base + "type");
+		std::ifstream sizeFile(base + "size");
+		int cacheLevel = 0;
+		std::string type, size;
+		if (!(levelFile >> cacheLevel) || !(typeFile >> type) || !(sizeFile >> size)) {
+			continue;
+		}
+		if (cacheLevel != level || (dataCache && type == "Instruction")) {
+			continue;
+		}
+		size_t value = std::stoul(size);
+		if (size.back() == 'K') {
+			value *= 1024;
+		}
+		else if (size.back() == 'M') {
+			value *= 1024 * 1024;
+		}
+		return value;
+	}
+	return 0;
+}
+#endif
+
+CacheSizes detectCacheSizes()
+{
+	CacheSizes sizes = { 0, 0, 0 };
+
+#ifdef _WIN32
+	DWORD length = 0;
+	GetLogicalProcessorInformation(nullptr, &length);
+	std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+	if (!info.empty() && GetLogicalProcessorInformation(info.data(), &length)) {
+		for (size_t i = 0; i < info.size(); i++) {
+			if (info[i].Relationship != RelationCache || info[i].Cache.Type == CacheInstruction) {
+				continue;
+			}
+			size_t size = info[i].Cache.Size;
+			switch (info[i].Cache.Level) {
+			case 1: sizes.l1 = sizes.l1 ? sizes.l1 : size; break;
+			case 2: sizes.l2 = sizes.l2 ? sizes.l2 : size; break;
+			case 3: sizes.l3 = sizes.l3 ? sizes.l3 : size; break;
+			}
+		}
+	}
+#else
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+	long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+	long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+	sizes.l1 = l1 > 0 ? (size_t)l1 : 0;
+	sizes.l2 = l2 > 0 ? (size_t)l2 : 0;
+	sizes.l3 = l3 > 0 ? (size_t)l3 : 0;
+#endif
+	if (sizes.l1 == 0) {
+		sizes.l1 = readSysfsCacheSize(1, true);
+	}
+	if (sizes.l2 == 0) {
+		sizes.l2 = readSysfsCacheSize(2, true);
+	}
+	if (sizes.l3 == 0) {
+		sizes.l3 = readSysfsCacheSize(3, true);
+	}
+#endif
+
+	if (sizes.l1 == 0) {
+		sizes.l1 = 32 * 1024;
+	}
+	if (sizes.l2 == 0) {
+		sizes.l2 = 256 * 1024;
+	}
+	if (sizes.l3 == 0) {
+		sizes.l3 = 8 * 1024 * 1024;
+	}
+	return sizes;
+}
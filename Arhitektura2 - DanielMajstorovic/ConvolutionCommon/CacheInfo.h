@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+// Velicine kesa (u bajtovima) procitane iz operativnog sistema; ako podatak nije dostupan
+// koriste se uobicajene vrijednosti (32 KB L1D, 256 KB L2, 8 MB L3)
+struct CacheSizes
+{
+    size_t l1;
+    size_t l2;
+    size_t l3;
+};
+
+CacheSizes detectCacheSizes();
@@ -0,0 +1,73 @@
+#include "CacheMissCounters.h"
+#include "PerfEvents.h"
+
+enum { L1Counter, L2Counter, LastLevelCounter };
+
+#ifdef __linux__
+// Sirovi L2 dogadjaj zavisi od proizvodjaca procesora
+static long long rawL2MissEvent()
+{
+	std::string vendor = readCpuVendor();
+	if (vendor == "GenuineIntel") {
+		return 0x3F24;
+	}
+	if (vendor == "AuthenticAMD") {
+		return 0x0964;
+	}
+	return -1;
+}
+#endif
+
+CacheMissCounters::CacheMissCounters()
+{
+	for (int i = 0; i < 3; i++) {
+		descriptors[i] = -1;
+		values[i] = -1;
+	}
+#ifdef __linux__
+	descriptors[L1Counter] = openPerfCounter(PERF_TYPE_HW_CACHE, perfCacheReadMiss(PERF_COUNT_HW_CACHE_L1D));
+	long long l2Event = rawL2MissEvent();
+	if (l2Event >= 0) {
+		descriptors[L2Counter] = openPerfCounter(PERF_TYPE_RAW, (unsigned long long)l2Event);
+	}
+	descriptors[LastLevelCounter] = openPerfCounter(PERF_TYPE_HW_CACHE, perfCacheReadMiss(PERF_COUNT_HW_CACHE_LL));
+	if (descriptors[LastLevelCounter] < 0) {
+		descriptors[LastLevelCounter] = openPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	}
+#endif
+}
+
+CacheMissCounters::~CacheMissCounters()
+{
+	closePerfCounters(descriptors, 3);
+}
+
+bool CacheMissCounters::isAvailable()
+{
+	return descriptors[L1Counter] >= 0 || descriptors[L2Counter] >= 0 || descriptors[LastLevelCounter] >= 0;
+}
+
+void CacheMissCounters::start()
+{
+	startPerfCounters(descriptors, 3);
+}
+
+void CacheMissCounters::stop()
+{
+	stopPerfCounters(descriptors, values, 3);
+}
+
+long long CacheMissCounters::getL1Misses()
+{
+	return values[L1Counter];
+}
+
+long long CacheMissCounters::getL2Misses()
+{
+	return values[L2Counter];
+}
+
+long long CacheMissCounters::getLastLevelMisses()
+{
+	return values[LastLevelCounter];
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// Brojaci promasaja kesa (L1D, L2 i posljednji nivo) za mjerenje efekta blokovskog izvrsavanja.
+// Na Linuxu se koristi perf_event_open sa nasljedjivanjem na niti, pa objekat treba napraviti prije
+// prvog OpenMP regiona da bi se brojale i radne niti. L2 nema generican dogadjaj, pa se koristi
+// sirovi dogadjaj za Intel (L2_RQSTS.MISS) ili AMD (L2CacheReqStat). Na ostalim sistemima, ili ako
+// kernel ne dozvoljava brojace, isAvailable() vraca false a vrijednosti su -1. Otvaranje, citanje i
+// skaliranje smjenjivanih brojaca dijeli sa PerformanceCounters (PerfEvents.h).
+class CacheMissCounters
+{
+    int descriptors[3];
+    long long values[3];
+
+public:
+    CacheMissCounters();
+    ~CacheMissCounters();
+    bool isAvailable();
+    void start();
+    void stop();
+    long long getL1Misses();
+    long long getL2Misses();
+    long long getLastLevelMisses();
+};
@@ -0,0 +1,125 @@
+#include "ConvolutionArguments.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+// Kreiranje kvadratnog kernela neparne dimenzije od niza koeficijenata
+static Mat parseKernel(const vector<char*>& values)
+{
+	int size = (int)values.size();
+	double sqrtSize = sqrt(size);
+
+	// Provjera da li je kernel kvadratnog oblika i neparne dimenzije
+	if (size % 2 == 0 || sqrtSize != floor(sqrtSize)) {
+		throw invalid_argument("Dimenzija kernela nije odgovarajuca");
+	}
+
+	// Ucitavanje kernela iz argumenata komandne linije
+	vector<double> kernelArray(size);
+	for (int i = 0; i < size; i++) {
+		kernelArray[i] = atof(values[i]);
+	}
+
+	// Kreiranje kernela koristeci ucitane vrijednosti
+	return Mat((int)sqrtSize, (int)sqrtSize, CV_64F, kernelArray.data()).clone();
+}
+
+ConvolutionArguments::ConvolutionArguments(int argc, char* argv[])
+{
+	// Odvajanje opcija od pozicionih argumenata; --stage (bez vrijednosti) razdvaja kernele faza
+	vector<char*> positional;
+	vector<size_t> stageBreaks;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		if (argument == "--stage") {
+			stageBreaks.push_back(positional.size());
+			options["stage"] = "";
+		}
+		else if (argument.size() > 2 && argument.compare(0, 2, "--") == 0) {
+			size_t equalsPosition = argument.find('=');
+			if (equalsPosition == string::npos) {
+				options[argument.substr(2)] = "";
+			}
+			else {
+				options[argument.substr(2, equalsPosition - 2)] = argument.substr(equalsPosition + 1);
+			}
+		}
+		else {
+			positional.push_back(argv[i]);
+		}
+	}
+
+	if (positional.size() < 2) {
+		throw invalid_argument("Unesite dovoljan broj argumenata!");
+	}
+	inputFilePath = positional[0];
+	outputFilePath = positional[1];
+
+	if (positional.size() == 2) {
+		// Podrazumijevano detekcija horizontalnih ivica
+		double defaultKernel[9] = {
+			-1, -1, -1,
+			2, 2, 2,
+			-1, -1, -1
+		};
+		kernels.push_back(Mat(3, 3, CV_64F, defaultKernel).clone()); // clone jer se defaultKernel dealocira
+	}
+	else
+	{
+		// Koeficijenti izmedju dva --stage separatora cine kernel jedne faze
+		size_t begin = 2;
+		stageBreaks.push_back(positional.size());
+		for (size_t b = 0; b < stageBreaks.size(); b++) {
+			size_t end = max(stageBreaks[b], begin);
+			if (end == begin && begin == 2) {
+				continue;
+			}
+			kernels.push_back(parseKernel(vector<char*>(positional.begin() + begin, positional.begin() + end)));
+			begin = end;
+		}
+	}
+	convolutionKernel = kernels[0];
+}
+
+char* ConvolutionArguments::getInputFilePath()
+{
+	return inputFilePath;
+}
+
+char* ConvolutionArguments::getOutputFilePath()
+{
+	return outputFilePath;
+}
+
+Mat ConvolutionArguments::getKernel()
+{
+	return convolutionKernel;
+}
+
+vector<Mat> ConvolutionArguments::getKernels()
+{
+	return kernels;
+}
+
+bool ConvolutionArguments::hasOption(const string& name)
+{
+	return options.count(name) > 0;
+}
+
+string ConvolutionArguments::getOption(const string& name, const string& defaultValue)
+{
+	auto option = options.find(name);
+	return option == options.end() ? defaultValue : option->second;
+}
+
+double ConvolutionArguments::getDoubleOption(const string& name, double defaultValue)
+{
+	auto option = options.find(name);
+	return option == options.end() ? defaultValue : atof(option->second.c_str());
+}
+
+int ConvolutionArguments::getIntOption(const string& name, int defaultValue)
+{
+	auto option = options.find(name);
+	return option == options.end() ? defaultValue : atoi(option->second.c_str());
+}
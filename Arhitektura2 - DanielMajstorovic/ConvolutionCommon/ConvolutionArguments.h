@@ -0,0 +1,30 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <map>
+#include <string>
+
+using namespace cv;
+using namespace std;
+
+// Argumenti komandne linije: ulaz izlaz [k1 k2 ... kn] [--opcija=vrijednost ...]
+// Opcije pocinju sa "--" i mogu se nalaziti bilo gdje, pa se ne mijesaju sa negativnim koeficijentima kernela.
+// Vise faza se zadaje kao ulaz izlaz k1 ... --stage k1 ... --stage ...; getKernel() vraca prvu fazu.
+class ConvolutionArguments
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    vector<Mat> kernels;
+    map<string, string> options;
+
+public:
+    ConvolutionArguments(int argc, char* argv[]);
+    char* getInputFilePath();
+    char* getOutputFilePath();
+    Mat getKernel();
+    vector<Mat> getKernels();
+    bool hasOption(const string& name);
+    string getOption(const string& name, const string& defaultValue);
+    double getDoubleOption(const string& name, double defaultValue);
+    int getIntOption(const string& name, int defaultValue);
+};
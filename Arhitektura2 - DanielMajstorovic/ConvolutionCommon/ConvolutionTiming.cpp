@@ -0,0 +1,13 @@
+#include "ConvolutionTiming.h"
+#include "BenchmarkStatistics.h"
+
+String measureExecutionTime(function<Mat()> convolution, int warmUpIterations, int testIterations)
+{
+	TimingStatistics statistics = summarizeTimings(collectTimings(convolution, warmUpIterations, testIterations));
+
+	String log = "Srednje vrijeme: ";
+	log += std::to_string(statistics.mean);
+	log += " Varijansa: ";
+	log += std::to_string(statistics.variance);
+	return log;
+}
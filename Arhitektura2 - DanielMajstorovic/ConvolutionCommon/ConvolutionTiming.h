@@ -0,0 +1,10 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+
+using namespace cv;
+using namespace std;
+
+// Zagrijavanje pa mjerenje izvrsavanja (collectTimings, summarizeTimings) za test() metode svih varijanti.
+// Vraca tekst oblika "Srednje vrijeme: x Varijansa: y".
+String measureExecutionTime(function<Mat()> convolution, int warmUpIterations = 3, int testIterations = 3);
@@ -0,0 +1,51 @@
+#include "ConvolutionWorkspace.h"
+#include "WorkStealingPool.h"
+
+ConvolutionWorkspace::ConvolutionWorkspace(NumaPlacement placement, HugePages hugePages)
+	: placement(placement), hugePages(hugePages)
+{
+	allocations = 0;
+}
+
+bool ConvolutionWorkspace::ensureBuffer(Mat& buffer, shared_ptr<void>& memory, int rows, int cols, int type)
+{
+	if (buffer.rows == rows && buffer.cols == cols && buffer.type() == type) {
+		return false;
+	}
+	// Stari bafer se oslobadja prije nove alokacije, pa vrh potrosnje ne raste
+	buffer.release();
+	memory.reset();
+	buffer = allocatePlacedImage(rows, cols, type, placement, hugePages, memory);
+	allocations++;
+	return true;
+}
+
+Mat& ConvolutionWorkspace::prepareAccumulator(int rows, int cols)
+{
+	ensureBuffer(accumulator, accumulatorMemory, rows, cols, CV_64FC3);
+	return accumulator;
+}
+
+Mat& ConvolutionWorkspace::convertToOutput(const Mat& source, bool parallel)
+{
+	ensureBuffer(output, outputMemory, source.rows, source.cols, CV_8UC3);
+	int samples = 3 * source.cols;
+	forEachIndex(source.rows, parallel, [&](int x) {
+		const double* row = source.ptr<double>(x);
+		uchar* destination = output.ptr<uchar>(x);
+		for (int i = 0; i < samples; i++) {
+			destination[i] = saturate_cast<uchar>(row[i]);
+		}
+	});
+	return output;
+}
+
+int ConvolutionWorkspace::getAllocationCount()
+{
+	return allocations;
+}
+
+NumaPlacement ConvolutionWorkspace::getPlacement()
+{
+	return placement;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include "NumaPlacement.h"
+
+using namespace cv;
+using namespace std;
+
+// Radni prostor za ponovljene konvolucije: 64F akumulator i 8-bitni izlaz alociraju se samo kada
+// se promijeni njihov oblik, pa ponovljeni pozivi iste varijante (npr. u test()) ne alociraju
+// memoriju velicine slike niti izazivaju nove page fault-ove. Prosirena kopija ulaza ne postoji:
+// ivice se racunaju direktno iz izvora (BorderHandling.h).
+// Rezultati koje vraca radni prostor dijele bafer s njim: sljedeci poziv ih prepisuje, pa ih
+// pozivalac koji ih cuva duze mora klonirati. Jedan radni prostor moze dijeliti vise varijanti
+// koje se izvrsavaju jedna za drugom, ali ne i istovremeno.
+// Baferi se uzimaju direktno od operativnog sistema i prvi upis odredjuje njihov NUMA cvor
+// (NumaPlacement.h); memoriju posjeduje radni prostor, pa vraceni rezultat ne nadzivljava ni njega.
+class ConvolutionWorkspace
+{
+    NumaPlacement placement;
+    HugePages hugePages;
+    Mat accumulator;
+    Mat output;
+    shared_ptr<void> accumulatorMemory;
+    shared_ptr<void> outputMemory;
+    int allocations;
+
+    bool ensureBuffer(Mat& buffer, shared_ptr<void>& memory, int rows, int cols, int type);
+
+public:
+    ConvolutionWorkspace(NumaPlacement placement = NumaAware, HugePages hugePages = HugePagesOff);
+    // Akumulator rows x cols (CV_64FC3); ne brise se, jer konvolucija upisuje svaki piksel
+    Mat& prepareAccumulator(int rows, int cols);
+    // Zaokruzivanje i saturacija u CV_8UC3, isto kao convertTo(CV_8UC3)
+    Mat& convertToOutput(const Mat& source, bool parallel);
+    // Broj alokacija od nastanka; u ustaljenom stanju se ne mijenja
+    int getAllocationCount();
+    NumaPlacement getPlacement();
+};
@@ -0,0 +1,135 @@
+#include "CpuFeatures.h"
+#include <stdexcept>
+#include <cstdlib>
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+static void readCpuid(unsigned int leaf, unsigned int subleaf, unsigned int registers[4])
+{
+#ifdef _MSC_VER
+	int values[4];
+	__cpuidex(values, (int)leaf, (int)subleaf);
+	for (int i = 0; i < 4; i++) {
+		registers[i] = (unsigned int)values[i];
+	}
+#else
+	registers[0] = registers[1] = registers[2] = registers[3] = 0;
+	__get_cpuid_count(leaf, subleaf, &registers[0], &registers[1], &registers[2], &registers[3]);
+#endif
+}
+
+// Registri koje operativni sistem cuva pri promjeni konteksta (XCR0)
+static unsigned long long readXcr0()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int low, high;
+	__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return ((unsigned long long)high << 32) | low;
+#endif
+}
+
+IsaLevel detectIsaLevel()
+{
+	unsigned int basic[4], extended[4];
+	readCpuid(0, 0, basic);
+	unsigned int maxLeaf = basic[0];
+	readCpuid(1, 0, basic);
+	if (maxLeaf >= 7) {
+		readCpuid(7, 0, extended);
+	}
+	else {
+		extended[0] = extended[1] = extended[2] = extended[3] = 0;
+	}
+
+	bool sse41 = (basic[2] & (1u << 19)) != 0;
+	bool fma = (basic[2] & (1u << 12)) != 0;
+	bool osxsave = (basic[2] & (1u << 27)) != 0;
+	bool avx = (basic[2] & (1u << 28)) != 0;
+	bool f16c = (basic[2] & (1u << 29)) != 0;
+	bool avx2 = (extended[1] & (1u << 5)) != 0;
+	bool avx512f = (extended[1] & (1u << 16)) != 0;
+
+	unsigned long long xcr0 = osxsave ? readXcr0() : 0;
+	bool ymmState = (xcr0 & 0x6) == 0x6;
+	bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+	// F16C postoji na svim procesorima sa AVX2, pa se AVX2 nivo koristi i za konverzije float16
+	if (avx512f && avx2 && fma && f16c && avx && ymmState && zmmState) {
+		return IsaAvx512;
+	}
+	if (avx2 && fma && f16c && avx && ymmState) {
+		return IsaAvx2;
+	}
+	if (sse41) {
+		return IsaSse41;
+	}
+	return IsaScalar;
+}
+
+static string readIsaEnvironment()
+{
+#ifdef _MSC_VER
+	char* value = nullptr;
+	size_t length = 0;
+	string result;
+	if (_dupenv_s(&value, &length, "CONV_ISA") == 0 && value != nullptr) {
+		result = value;
+		free(value);
+	}
+	return result;
+#else
+	const char* value = getenv("CONV_ISA");
+	return value != nullptr ? value : "";
+#endif
+}
+
+IsaLevel selectIsaLevel(const string& requested)
+{
+	string name = requested.empty() ? readIsaEnvironment() : requested;
+	IsaLevel available = detectIsaLevel();
+	if (name.empty() || name == "auto") {
+		return available;
+	}
+
+	IsaLevel level;
+	if (name == "scalar") {
+		level = IsaScalar;
+	}
+	else if (name == "sse4.1" || name == "sse41") {
+		level = IsaSse41;
+	}
+	else if (name == "avx2") {
+		level = IsaAvx2;
+	}
+	else if (name == "avx512") {
+		level = IsaAvx512;
+	}
+	else {
+		throw invalid_argument("Nivo instrukcija mora biti auto, scalar, sse4.1, avx2 ili avx512");
+	}
+
+	if (level > available) {
+		throw invalid_argument("Procesor ne podrzava " + name + " (najvise " + getIsaLevelName(available) + ")");
+	}
+	return level;
+}
+
+string getIsaLevelName(IsaLevel level)
+{
+	switch (level) {
+	case IsaSse41:
+		return "sse4.1";
+	case IsaAvx2:
+		return "avx2";
+	case IsaAvx512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+
+using namespace std;
+
+// Nivoi skupa instrukcija za koje postoje posebno prevedene verzije petlji
+enum IsaLevel
+{
+    IsaScalar,
+    IsaSse41,
+    IsaAvx2,
+    IsaAvx512
+};
+
+// Najvisi nivo koji podrzavaju i procesor (CPUID) i operativni sistem (XGETBV cuva YMM/ZMM registre);
+// AVX2 nivo ukljucuje FMA i F16C
+IsaLevel detectIsaLevel();
+
+// Nivo zadat kao scalar, sse4.1, avx2 ili avx512; "auto" ili prazan tekst znaci detectIsaLevel().
+// Ako requested nije zadat, koristi se promjenljiva okruzenja CONV_ISA. Nivo koji procesor ne
+// podrzava prijavljuje se izuzetkom invalid_argument.
+IsaLevel selectIsaLevel(const string& requested);
+
+string getIsaLevelName(IsaLevel level);
@@ -0,0 +1,373 @@
+#include "DistributedConvolution.h"
+#include "NumaPlacement.h"
+#include <omp.h>
+#include <stdexcept>
+#include <vector>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+static bool sendBytes(int descriptor, const void* data, size_t size)
+{
+	const char* bytes = (const char*)data;
+	while (size > 0) {
+		// MSG_NOSIGNAL: prekinut radnik vraca gresku umjesto da SIGPIPE zavrsi koordinatora
+		ssize_t sent = send(descriptor, bytes, size, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR) {
+			continue;
+		}
+		if (sent <= 0) {
+			return false;
+		}
+		bytes += sent;
+		size -= sent;
+	}
+	return true;
+}
+
+static bool receiveBytes(int descriptor, void* data, size_t size)
+{
+	char* bytes = (char*)data;
+	while (size > 0) {
+		ssize_t received = recv(descriptor, bytes, size, 0);
+		if (received < 0 && errno == EINTR) {
+			continue;
+		}
+		if (received <= 0) {
+			return false;
+		}
+		bytes += received;
+		size -= received;
+	}
+	return true;
+}
+
+// Redovi pravougaonika region jedan za drugim, bez pakovanja u poseban bafer
+static bool sendRegion(int descriptor, const Mat& image, Rect region)
+{
+	for (int x = region.y; x < region.y + region.height; x++) {
+		if (!sendBytes(descriptor, image.ptr<uchar>(x) + region.x * image.elemSize(), region.width * image.elemSize())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool receiveRegion(int descriptor, Mat& image, Rect region)
+{
+	for (int x = region.y; x < region.y + region.height; x++) {
+		if (!receiveBytes(descriptor, image.ptr<uchar>(x) + region.x * image.elemSize(), region.width * image.elemSize())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Susjed u jednom smjeru: socket prema drugom radniku, sam radnik (wrap sa jednim blokom na osi) ili nijedan
+struct HaloLink
+{
+	int descriptor;
+	bool self;
+};
+
+// Razmjena oreola na jednoj osi: prvi susjed je sjeverni (zapadni), drugi juzni (istocni). Oreol ide
+// kao jedan kontinualan bafer (kolone oreola imaju redove od samo nekoliko piksela), a svaki smjer
+// salje iz svoje niti dok ova prima, pa dva radnika koji salju jedan drugom ne mogu zaglaviti
+static size_t exchangeHalos(Mat& local, HaloLink first, HaloLink second, Rect sendFirst, Rect sendSecond, Rect receiveFirst, Rect receiveSecond)
+{
+	if (first.self) {
+		Mat fromFirst = local(receiveFirst);
+		Mat fromSecond = local(receiveSecond);
+		local(sendSecond).copyTo(fromFirst);
+		local(sendFirst).copyTo(fromSecond);
+		return 0;
+	}
+
+	HaloLink links[2] = { first, second };
+	Rect targets[2] = { receiveFirst, receiveSecond };
+	Mat outgoing[2] = { local(sendFirst).clone(), local(sendSecond).clone() };
+	Mat incoming[2];
+	bool sent[2] = { true, true };
+	vector<thread> senders;
+	for (int k = 0; k < 2; k++) {
+		if (links[k].descriptor >= 0) {
+			senders.emplace_back([&, k]() {
+				sent[k] = sendBytes(links[k].descriptor, outgoing[k].data, outgoing[k].total() * outgoing[k].elemSize());
+			});
+		}
+	}
+	bool received = true;
+	for (int k = 0; k < 2; k++) {
+		if (links[k].descriptor >= 0) {
+			incoming[k].create(targets[k].height, targets[k].width, local.type());
+			received = received && receiveBytes(links[k].descriptor, incoming[k].data, incoming[k].total() * incoming[k].elemSize());
+		}
+	}
+	for (thread& sender : senders) {
+		sender.join();
+	}
+	if (!sent[0] || !sent[1] || !received) {
+		throw invalid_argument("Razmjena oreola sa susjednim radnikom nije uspjela");
+	}
+
+	size_t bytes = 0;
+	for (int k = 0; k < 2; k++) {
+		if (links[k].descriptor >= 0) {
+			Mat target = local(targets[k]);
+			incoming[k].copyTo(target);
+			bytes += outgoing[k].total() * outgoing[k].elemSize();
+		}
+	}
+	return bytes;
+}
+#endif
+
+DistributedConvolution::DistributedConvolution(int kernelSize, BorderMode borderMode, int threadsPerWorker, const function<Mat(const Mat&)>& convolution)
+	: kernelSize(kernelSize), borderMode(borderMode), threadsPerWorker(threadsPerWorker), convolution(convolution)
+{
+}
+
+void DistributedConvolution::chooseGrid(int workers, Size imageSize, int& gridRows, int& gridCols)
+{
+	// Svaka unutrasnja granica mreze prenosi oreol duz cijele slike: (gridRows - 1) x sirina + (gridCols - 1) x visina
+	gridRows = workers;
+	gridCols = 1;
+	long long best = -1;
+	for (int rows = 1; rows <= workers; rows++) {
+		if (workers % rows != 0) {
+			continue;
+		}
+		int cols = workers / rows;
+		long long cost = (long long)(rows - 1) * imageSize.width + (long long)(cols - 1) * imageSize.height;
+		if (best < 0 || cost < best || (cost == best && rows > gridRows)) {
+			best = cost;
+			gridRows = rows;
+			gridCols = cols;
+		}
+	}
+}
+
+Mat DistributedConvolution::run(const Mat& image, int workers, DistributedRun& statistics)
+{
+#ifdef _WIN32
+	throw invalid_argument("Distribuirana konvolucija zahtijeva POSIX sistem (fork i lokalne sokete)");
+#else
+	if (image.type() != CV_8UC3) {
+		throw invalid_argument("Ulazna slika mora biti CV_8UC3");
+	}
+	if (workers < 1) {
+		throw invalid_argument("Broj radnika mora biti bar 1");
+	}
+
+	int half = kernelSize / 2;
+	int gridRows, gridCols;
+	chooseGrid(workers, image.size(), gridRows, gridCols);
+	if (image.rows / gridRows < max(half, 1) || image.cols / gridCols < max(half, 1)) {
+		throw invalid_argument("Blokovi bi bili manji od pola kernela; smanjite broj radnika");
+	}
+
+	vector<Rect> blocks(workers);
+	for (int w = 0; w < workers; w++) {
+		int r = w / gridCols, c = w % gridCols;
+		int top = r * image.rows / gridRows, bottom = (r + 1) * image.rows / gridRows;
+		int left = c * image.cols / gridCols, right = (c + 1) * image.cols / gridCols;
+		blocks[w] = Rect(left, top, right - left, bottom - top);
+	}
+
+	// Susjed u mrezi (kod wrap periodicno), -1 na ivici slike
+	bool periodic = borderMode == BorderWrap;
+	auto neighbour = [&](int w, int dr, int dc) {
+		int r = w / gridCols + dr, c = w % gridCols + dc;
+		if (periodic) {
+			r = (r + gridRows) % gridRows;
+			c = (c + gridCols) % gridCols;
+		}
+		return r < 0 || r >= gridRows || c < 0 || c >= gridCols ? -1 : r * gridCols + c;
+	};
+
+	// Par socketa prema koordinatoru za svakog radnika i po jedan za juznu i istocnu granicu bloka
+	// (sjeverna i zapadna granica su juzna i istocna granica susjeda)
+	vector<int> coordinatorSockets(2 * workers, -1), southSockets(2 * workers, -1), eastSockets(2 * workers, -1);
+	auto closeAll = [&]() {
+		for (vector<int>* sockets : { &coordinatorSockets, &southSockets, &eastSockets }) {
+			for (int& descriptor : *sockets) {
+				if (descriptor >= 0) {
+					close(descriptor);
+					descriptor = -1;
+				}
+			}
+		}
+	};
+	for (int w = 0; w < workers; w++) {
+		bool created = socketpair(AF_UNIX, SOCK_STREAM, 0, &coordinatorSockets[2 * w]) == 0;
+		int south = neighbour(w, 1, 0), east = neighbour(w, 0, 1);
+		if (created && south >= 0 && south != w) {
+			created = socketpair(AF_UNIX, SOCK_STREAM, 0, &southSockets[2 * w]) == 0;
+		}
+		if (created && east >= 0 && east != w) {
+			created = socketpair(AF_UNIX, SOCK_STREAM, 0, &eastSockets[2 * w]) == 0;
+		}
+		if (!created) {
+			closeAll();
+			throw invalid_argument("Lokalni socketi za radnike se ne mogu napraviti");
+		}
+	}
+
+	int threads = threadsPerWorker > 0 ? threadsPerWorker : max(1, omp_get_num_procs() / workers);
+	// Svaki radnik dobija svoj dio procesora prije fork-a, da vezivanje niti (--affinity) u radnicima
+	// ne bi sve skupove stavilo na iste procesore
+	vector<vector<int>> cpuShares = splitAffinityCpus(workers);
+	vector<pid_t> processes;
+	for (int w = 0; w < workers; w++) {
+		pid_t process = fork();
+		if (process < 0) {
+			break;
+		}
+		if (process > 0) {
+			processes.push_back(process);
+			continue;
+		}
+
+		// Radni proces: blok sa oreolom od pola kernela sa svake strane
+		int status = 0;
+		try {
+			Rect block = blocks[w];
+			int coordinator = coordinatorSockets[2 * w + 1];
+			int north = neighbour(w, -1, 0), south = neighbour(w, 1, 0);
+			int west = neighbour(w, 0, -1), east = neighbour(w, 0, 1);
+			HaloLink northLink = { north >= 0 && north != w ? southSockets[2 * north + 1] : -1, north == w };
+			HaloLink southLink = { south >= 0 && south != w ? southSockets[2 * w] : -1, south == w };
+			HaloLink westLink = { west >= 0 && west != w ? eastSockets[2 * west + 1] : -1, west == w };
+			HaloLink eastLink = { east >= 0 && east != w ? eastSockets[2 * w] : -1, east == w };
+
+			// Tudji krajevi se zatvaraju, da bi prekid jednog procesa bio kraj toka za njegove susjede
+			int kept[5] = { coordinator, northLink.descriptor, southLink.descriptor, westLink.descriptor, eastLink.descriptor };
+			for (vector<int>* sockets : { &coordinatorSockets, &southSockets, &eastSockets }) {
+				for (int descriptor : *sockets) {
+					if (descriptor >= 0 && find(begin(kept), end(kept), descriptor) == end(kept)) {
+						close(descriptor);
+					}
+				}
+			}
+
+			if (getAffinityPolicy() != AffinityNone) {
+				restrictAffinity(cpuShares[w]);
+			}
+			omp_set_num_threads(threads);
+			int height = block.height + 2 * half;
+			int width = block.width + 2 * half;
+			Mat local(height, width, CV_8UC3, Scalar(0, 0, 0));
+			if (!receiveRegion(coordinator, local, Rect(half, half, block.width, block.height))) {
+				throw invalid_argument("Blok nije primljen");
+			}
+
+			unsigned long long haloBytes = 0;
+			if (half > 0) {
+				haloBytes += exchangeHalos(local, northLink, southLink,
+					Rect(half, half, block.width, half), Rect(half, block.height, block.width, half),
+					Rect(half, 0, block.width, half), Rect(half, block.height + half, block.width, half));
+
+				// Oreol na ivici slike: indeks van slike preslikan prema nacinu prosirenja lezi u bloku ili u
+				// oreolu vec primljenom od suprotnog susjeda (blok nije manji od pola kernela)
+				if (borderMode == BorderReplicate || borderMode == BorderReflect101) {
+					for (int x = 0; x < height; x++) {
+						int globalRow = block.y - half + x;
+						if ((x < half && north < 0) || (x >= half + block.height && south < 0)) {
+							int sourceRow = mapBorderIndex(globalRow, image.rows, borderMode) - block.y + half;
+							memcpy(local.ptr<uchar>(x), local.ptr<uchar>(sourceRow), width * local.elemSize());
+						}
+					}
+				}
+
+				// Kolone preko cijele prosirene visine, pa stizu i uglovi dijagonalnih susjeda
+				haloBytes += exchangeHalos(local, westLink, eastLink,
+					Rect(half, 0, half, height), Rect(block.width, 0, half, height),
+					Rect(0, 0, half, height), Rect(block.width + half, 0, half, height));
+
+				if (borderMode == BorderReplicate || borderMode == BorderReflect101) {
+					for (int y = 0; y < width; y++) {
+						int globalCol = block.x - half + y;
+						if ((y < half && west < 0) || (y >= half + block.width && east < 0)) {
+							int sourceCol = mapBorderIndex(globalCol, image.cols, borderMode) - block.x + half;
+							for (int x = 0; x < height; x++) {
+								local.at<Vec3b>(x, y) = local.at<Vec3b>(x, sourceCol);
+							}
+						}
+					}
+				}
+			}
+
+			double start = omp_get_wtime();
+			Mat result = convolution(local);
+			double computeSeconds = omp_get_wtime() - start;
+
+			if (!sendRegion(coordinator, result, Rect(half, half, block.width, block.height)) ||
+				!sendBytes(coordinator, &computeSeconds, sizeof(computeSeconds)) ||
+				!sendBytes(coordinator, &haloBytes, sizeof(haloBytes))) {
+				status = 1;
+			}
+		}
+		catch (const exception&) {
+			status = 1;
+		}
+		// _exit: radnik ne smije pokrenuti destruktore i ispraznjavanje bafera naslijedjene od koordinatora
+		_exit(status);
+	}
+
+	// Koordinator zadrzava samo svoje krajeve socketa prema radnicima
+	for (int w = 0; w < workers; w++) {
+		close(coordinatorSockets[2 * w + 1]);
+		coordinatorSockets[2 * w + 1] = -1;
+	}
+	for (vector<int>* sockets : { &southSockets, &eastSockets }) {
+		for (int& descriptor : *sockets) {
+			if (descriptor >= 0) {
+				close(descriptor);
+				descriptor = -1;
+			}
+		}
+	}
+
+	bool complete = (int)processes.size() == workers;
+	Mat resultImage(image.rows, image.cols, CV_8UC3);
+	statistics.workers = workers;
+	statistics.gridRows = gridRows;
+	statistics.gridCols = gridCols;
+	statistics.computeSeconds = 0;
+	statistics.haloBytes = 0;
+
+	double start = omp_get_wtime();
+	for (int w = 0; w < workers && complete; w++) {
+		complete = sendRegion(coordinatorSockets[2 * w], image, blocks[w]);
+	}
+	for (int w = 0; w < workers && complete; w++) {
+		double computeSeconds = 0;
+		unsigned long long haloBytes = 0;
+		Mat target = resultImage(blocks[w]);
+		complete = receiveRegion(coordinatorSockets[2 * w], target, Rect(0, 0, blocks[w].width, blocks[w].height)) &&
+			receiveBytes(coordinatorSockets[2 * w], &computeSeconds, sizeof(computeSeconds)) &&
+			receiveBytes(coordinatorSockets[2 * w], &haloBytes, sizeof(haloBytes));
+		statistics.computeSeconds = max(statistics.computeSeconds, computeSeconds);
+		statistics.haloBytes += (size_t)haloBytes;
+	}
+	statistics.seconds = omp_get_wtime() - start;
+
+	closeAll();
+	for (pid_t process : processes) {
+		int status = 0;
+		waitpid(process, &status, 0);
+		complete = complete && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	}
+	if (!complete) {
+		throw invalid_argument("Radni procesi nisu vratili rezultat za " + to_string(workers) + " radnika");
+	}
+	return resultImage;
+#endif
+}
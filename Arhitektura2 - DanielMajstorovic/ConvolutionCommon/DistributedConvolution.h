@@ -0,0 +1,44 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Rezultat jednog distribuiranog izvrsavanja
+struct DistributedRun
+{
+    int workers;
+    int gridRows;
+    int gridCols;
+    // Od slanja blokova do sastavljenog rezultata (bez pokretanja procesa)
+    double seconds;
+    // Najduze racunanje jednog radnika (bez razmjene)
+    double computeSeconds;
+    // Ukupno bajtova oreola razmijenjenih izmedju radnika
+    size_t haloBytes;
+};
+
+// Podjela slike na mrezu gridRows x gridCols blokova izmedju radnih procesa (fork, lokalni socketi).
+// Koordinator salje svakom radniku samo njegov blok; radnici medjusobno razmjenjuju samo oreole od
+// pola kernela (prvo redove sa sjevernim i juznim susjedom, zatim kolone, vec prosirene oreolom, sa
+// zapadnim i istocnim, pa i uglove), racunaju prosireni blok postojecom varijantom (convolution) i
+// vracaju unutrasnjost koordinatoru, koji sastavlja izlaz. Oreoli na ivici slike popunjavaju se
+// prema nacinu prosirenja, a kod wrap susjedi su periodicni, pa je rezultat isti kao u jednom procesu.
+// Radi samo na POSIX sistemima; procesi se prave prije bilo kakvog paralelnog rada koordinatora, jer
+// fork ne kopira niti skupa.
+class DistributedConvolution
+{
+    int kernelSize;
+    BorderMode borderMode;
+    int threadsPerWorker;
+    function<Mat(const Mat&)> convolution;
+
+public:
+    // threadsPerWorker niti skupa u svakom radniku (0 = jezgra podijeljena na radnike)
+    DistributedConvolution(int kernelSize, BorderMode borderMode, int threadsPerWorker, const function<Mat(const Mat&)>& convolution);
+    // Mreza sa najmanje bajtova oreola za dati broj radnika
+    static void chooseGrid(int workers, Size imageSize, int& gridRows, int& gridCols);
+    Mat run(const Mat& image, int workers, DistributedRun& statistics);
+};
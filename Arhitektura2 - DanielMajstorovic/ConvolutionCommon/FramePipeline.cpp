@@ -0,0 +1,162 @@
+#include "FramePipeline.h"
+#include "BoundedQueue.h"
+#include "BenchmarkStatistics.h"
+#include <omp.h>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+static String formatMilliseconds(double seconds)
+{
+	return to_string(seconds * 1000) + " ms";
+}
+
+FramePipeline::FramePipeline(int bufferCount, const String& fourcc)
+	: bufferCount(max(bufferCount, 2)), fourcc(fourcc)
+{
+	if (fourcc.size() != 4) {
+		throw invalid_argument("Opcija --fourcc mora imati tacno 4 znaka");
+	}
+}
+
+String FramePipeline::run(const String& inputPath, const String& outputPath, const function<void(const Mat&, Mat&)>& convolution, int frameLimit)
+{
+	VideoCapture capture(inputPath);
+	if (!capture.isOpened()) {
+		throw invalid_argument("Ulaz " + inputPath + " se ne moze otvoriti kao video ili niz slika");
+	}
+	double framesPerSecond = capture.get(CAP_PROP_FPS);
+	if (framesPerSecond <= 0) {
+		framesPerSecond = 25;
+	}
+	bool imageSequence = outputPath.find('%') != String::npos;
+	int codec = imageSequence ? 0 : VideoWriter::fourcc(fourcc[0], fourcc[1], fourcc[2], fourcc[3]);
+
+	// Baferi se alociraju unaprijed kada izvor zna dimenziju okvira; inace ih alocira prvi okvir
+	// svakog bafera, a dalje read i konvolucija samo prepisuju postojecu memoriju
+	vector<Mat> inputFrames(bufferCount);
+	vector<Mat> outputFrames(bufferCount);
+	int width = (int)capture.get(CAP_PROP_FRAME_WIDTH);
+	int height = (int)capture.get(CAP_PROP_FRAME_HEIGHT);
+	if (width > 0 && height > 0) {
+		for (int k = 0; k < bufferCount; k++) {
+			inputFrames[k].create(height, width, CV_8UC3);
+			outputFrames[k].create(height, width, CV_8UC3);
+		}
+	}
+
+	// Redovi nose indekse bafera: slobodni ulazni -> dekodirani -> (konvolucija) -> izracunati -> slobodni izlazni.
+	// Trenutak pocetka dekodiranja prati okvir iz ulaznog u izlazni bafer radi kasnjenja
+	BoundedQueue<int> freeInputs(bufferCount);
+	BoundedQueue<int> decoded(bufferCount);
+	BoundedQueue<int> computed(bufferCount);
+	BoundedQueue<int> freeOutputs(bufferCount);
+	for (int k = 0; k < bufferCount; k++) {
+		freeInputs.push(k);
+		freeOutputs.push(k);
+	}
+	vector<double> inputStarted(bufferCount);
+	vector<double> outputStarted(bufferCount);
+
+	vector<double> latencies;
+	vector<double> computeTimes;
+	double decodeTime = 0, encodeTime = 0, computeWaitTime = 0;
+	atomic<bool> writeFailed(false);
+	String failure;
+
+	double start = omp_get_wtime();
+
+	thread decoder([&]() {
+		int slot;
+		int frames = 0;
+		while ((frameLimit <= 0 || frames < frameLimit) && freeInputs.pop(slot)) {
+			double begin = omp_get_wtime();
+			if (!capture.read(inputFrames[slot])) {
+				break;
+			}
+			decodeTime += omp_get_wtime() - begin;
+			inputStarted[slot] = begin;
+			if (!decoded.push(slot)) {
+				break;
+			}
+			frames++;
+		}
+		decoded.close();
+	});
+
+	thread encoder([&]() {
+		VideoWriter writer;
+		int slot;
+		while (computed.pop(slot)) {
+			double begin = omp_get_wtime();
+			const Mat& frame = outputFrames[slot];
+			if (!writeFailed && !writer.isOpened() && !writer.open(outputPath, codec, framesPerSecond, frame.size(), true)) {
+				writeFailed = true;
+				cerr << "Izlaz " << outputPath << " se ne moze otvoriti za upis" << endl;
+			}
+			if (!writeFailed) {
+				writer.write(frame);
+			}
+			double end = omp_get_wtime();
+			encodeTime += end - begin;
+			latencies.push_back(end - outputStarted[slot]);
+			freeOutputs.push(slot);
+		}
+		writer.release();
+	});
+
+	// Konvolucija u pozivajucoj niti, koja dijeli posao skupu niti kao i kod obicne konvolucije
+	int inputSlot, outputSlot;
+	double waitBegin = omp_get_wtime();
+	while (decoded.pop(inputSlot)) {
+		if (!freeOutputs.pop(outputSlot)) {
+			break;
+		}
+		double begin = omp_get_wtime();
+		computeWaitTime += begin - waitBegin;
+		try {
+			convolution(inputFrames[inputSlot], outputFrames[outputSlot]);
+		}
+		catch (const exception& error) {
+			failure = error.what();
+			break;
+		}
+		computeTimes.push_back(omp_get_wtime() - begin);
+		outputStarted[outputSlot] = inputStarted[inputSlot];
+		freeInputs.push(inputSlot);
+		computed.push(outputSlot);
+		waitBegin = omp_get_wtime();
+	}
+	// Zatvaranje svih redova oslobadja dekoder i kada se konvolucija prekine zbog greske
+	freeInputs.close();
+	decoded.close();
+	computed.close();
+	decoder.join();
+	encoder.join();
+	double totalTime = omp_get_wtime() - start;
+
+	if (!failure.empty()) {
+		throw invalid_argument("Konvolucija okvira nije uspjela: " + failure);
+	}
+	if (writeFailed) {
+		throw invalid_argument("Izlaz " + outputPath + " se ne moze upisati");
+	}
+
+	TimingStatistics latency = summarizeTimings(latencies);
+	TimingStatistics compute = summarizeTimings(computeTimes);
+	int frames = (int)latencies.size();
+	String report = "Obradjeno okvira: " + to_string(frames);
+	if (frames > 0) {
+		report += " (" + to_string(outputFrames[0].cols) + " x " + to_string(outputFrames[0].rows) + ")";
+	}
+	report += ", baferi: " + to_string(bufferCount);
+	report += "\nUkupno vrijeme: " + to_string(totalTime) + " s, odrzivo " + to_string(totalTime > 0 ? frames / totalTime : 0.0) + " okvira/s";
+	report += "\nKasnjenje okvira: medijan " + formatMilliseconds(latency.median) + ", p95 " + formatMilliseconds(latency.p95) + ", p99 " + formatMilliseconds(latency.p99);
+	report += "\nRacunanje po okviru: medijan " + formatMilliseconds(compute.median) + ", p95 " + formatMilliseconds(compute.p95);
+	report += "\nDekodiranje: " + to_string(decodeTime) + " s, racunanje: " + to_string(compute.mean * compute.samples) + " s, kodiranje: " + to_string(encodeTime) + " s";
+	report += "\nRacunanje je cekalo na ulaz: " + to_string(computeWaitTime) + " s";
+	return report;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija niza okvira (video fajl ili numerisan niz slika, npr. okvir_%04d.png, preko
+// VideoCapture) u tri niti: dekodiranje, konvolucija i kodiranje (VideoWriter; izlaz sa % je niz
+// slika). Ulazni i izlazni okviri su u po bufferCount unaprijed alociranih bafera (2 = dvostruko
+// baferovanje) koji kruze izmedju faza, pa se dok se okvir N racuna okvir N + 1 vec dekodira u drugi
+// bafer, a okvir N - 1 kodira. Konvolucija upisuje rezultat direktno u izlazni bafer (setOutputImage
+// varijante), pa okvir nema ni alokaciju ni kopiju rezultata.
+class FramePipeline
+{
+    int bufferCount;
+    String fourcc;
+
+public:
+    // fourcc je kodek izlaznog videa (4 znaka, npr. MJPG); za niz slika se ne koristi
+    FramePipeline(int bufferCount, const String& fourcc);
+    // Obradjuje najvise frameLimit okvira (0 = sve) i vraca izvjestaj: odrzivi broj okvira u sekundi,
+    // percentili kasnjenja okvira (od pocetka dekodiranja do kraja upisa) i vrijeme po fazama.
+    // convolution(ulaz, izlaz) upisuje u izlaz; prazan izlazni bafer (nepoznata dimenzija) alocira sama
+    String run(const String& inputPath, const String& outputPath, const function<void(const Mat&, Mat&)>& convolution, int frameLimit);
+};
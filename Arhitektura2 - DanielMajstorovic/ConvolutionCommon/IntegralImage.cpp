@@ -0,0 +1,105 @@
+#include "IntegralImage.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+IntegralImage::IntegralImage()
+{
+	padding = 0;
+	rows = 0;
+	cols = 0;
+}
+
+void IntegralImage::compute(const Mat& image, int padding, BorderMode borderMode, bool parallel)
+{
+	if (image.type() != CV_8UC3) {
+		throw invalid_argument("Ulazna slika mora biti CV_8UC3");
+	}
+	if (padding < 0) {
+		throw invalid_argument("Prosirenje integralne slike ne moze biti negativno");
+	}
+	this->padding = padding;
+	rows = image.rows;
+	cols = image.cols;
+	int paddedRows = rows + 2 * padding;
+	int paddedCols = cols + 2 * padding;
+
+	// Red i kolona nula ispred slike, da pravougaonik od ivice ne treba poseban slucaj
+	sums.create(paddedRows + 1, paddedCols + 1, CV_64FC3);
+	memset(sums.ptr<double>(0), 0, sums.cols * 3 * sizeof(double));
+
+	vector<int> sourceCols(paddedCols);
+	for (int j = 0; j < paddedCols; j++) {
+		sourceCols[j] = mapBorderIndex(j - padding, cols, borderMode);
+	}
+
+	// Prvi prolaz: prefiksni zbir po redu, redovi su nezavisni
+	forEachIndex(paddedRows, parallel, [&](int i) {
+		int sourceRow = mapBorderIndex(i - padding, rows, borderMode);
+		const uchar* source = sourceRow >= 0 ? image.ptr<uchar>(sourceRow) : nullptr;
+		double* destination = sums.ptr<double>(i + 1);
+		double r = 0, g = 0, b = 0;
+		destination[0] = destination[1] = destination[2] = 0;
+		for (int j = 0; j < paddedCols; j++) {
+			if (source != nullptr && sourceCols[j] >= 0) {
+				const uchar* pixel = source + 3 * sourceCols[j];
+				r += pixel[0];
+				g += pixel[1];
+				b += pixel[2];
+			}
+			destination[3 * (j + 1)] = r;
+			destination[3 * (j + 1) + 1] = g;
+			destination[3 * (j + 1) + 2] = b;
+		}
+	});
+
+	// Drugi prolaz: zbir niz kolone; trake od 512 vrijednosti (4 KB po redu) ostaju u kesu izmedju
+	// susjednih redova, a unutar trake petlja ide uzastopnim adresama
+	const int stripeWidth = 512;
+	int samples = 3 * (paddedCols + 1);
+	int stripes = (samples + stripeWidth - 1) / stripeWidth;
+	forEachIndex(stripes, parallel, [&](int stripe) {
+		int first = stripe * stripeWidth;
+		int last = min(first + stripeWidth, samples);
+		for (int i = 2; i <= paddedRows; i++) {
+			const double* above = sums.ptr<double>(i - 1);
+			double* current = sums.ptr<double>(i);
+			for (int k = first; k < last; k++) {
+				current[k] += above[k];
+			}
+		}
+	});
+}
+
+int IntegralImage::getPadding() const
+{
+	return padding;
+}
+
+void IntegralImage::filterBox(int boxRows, int boxCols, double weight, Mat& output, bool parallel) const
+{
+	int halfRows = boxRows / 2;
+	int halfCols = boxCols / 2;
+	if (boxRows < 1 || boxCols < 1 || halfRows > padding || boxRows - 1 - halfRows > padding || halfCols > padding || boxCols - 1 - halfCols > padding) {
+		throw invalid_argument("Prozor je veci od prosirenja integralne slike");
+	}
+
+	output.create(rows, cols, CV_8UC3);
+	forEachIndex(rows, parallel, [&](int x) {
+		// Red x slike je red x + padding prosirene; prozor pokriva redove [top, top + boxRows)
+		int top = x + padding - halfRows;
+		const double* upper = sums.ptr<double>(top);
+		const double* lower = sums.ptr<double>(top + boxRows);
+		uchar* destination = output.ptr<uchar>(x);
+		for (int y = 0; y < cols; y++) {
+			int left = 3 * (y + padding - halfCols);
+			int right = left + 3 * boxCols;
+			for (int c = 0; c < 3; c++) {
+				double sum = lower[right + c] - lower[left + c] - upper[right + c] + upper[left + c];
+				destination[3 * y + c] = saturate_cast<uchar>(sum * weight);
+			}
+		}
+	});
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Integralna slika (summed-area table) CV_8UC3 slike prosirene sa svake strane za padding piksela
+// prema nacinu prosirenja: S(i, j) je zbir svih piksela iznad i lijevo od (i, j), pa je zbir bilo kog
+// pravougaonika cetiri citanja bez obzira na velicinu. Zbirovi su u double, sto je tacno za cijele
+// brojeve do 2^53 (slike do ~3.5e13 piksela). Jednom izracunata, sluzi za sve prozore do
+// (2 * padding + 1) x (2 * padding + 1) iste slike.
+class IntegralImage
+{
+    Mat sums;
+    int padding;
+    int rows;
+    int cols;
+
+public:
+    IntegralImage();
+    // Dva prolaza: prefiksni zbir svakog reda (paralelno po redovima), pa zbir niz kolone
+    // (paralelno po trakama kolona, svaka traka ide od vrha do dna)
+    void compute(const Mat& image, int padding, BorderMode borderMode, bool parallel);
+    int getPadding() const;
+    // Za svaki piksel zbir prozora boxRows x boxCols (pocetak na x - boxRows / 2, kao kod kernela)
+    // pomnozen sa weight i zaokruzen u CV_8UC3
+    void filterBox(int boxRows, int boxCols, double weight, Mat& output, bool parallel) const;
+};
@@ -0,0 +1,77 @@
+#include "KernelDecomposition.h"
+#include <cmath>
+
+// Singularne vrijednosti manje od ovog udjela najvece smatraju se numerickom nulom
+static const double rankEpsilon = 1e-12;
+
+KernelDecomposition::KernelDecomposition(Mat kernel, double tolerance)
+{
+	Mat singularValues, u, vt;
+	SVD::compute(kernel, singularValues, u, vt);
+
+	double totalEnergy = 0;
+	for (int i = 0; i < singularValues.rows; i++) {
+		totalEnergy += singularValues.at<double>(i) * singularValues.at<double>(i);
+	}
+
+	fullRank = 0;
+	for (int i = 0; i < singularValues.rows; i++) {
+		if (singularValues.at<double>(i) > rankEpsilon * singularValues.at<double>(0)) {
+			fullRank++;
+		}
+	}
+
+	// Dodavanje clanova dok ostatak ne padne ispod tolerancije
+	double remainingEnergy = totalEnergy;
+	int rank = 0;
+	while (rank < fullRank && (totalEnergy == 0 || sqrt(max(remainingEnergy, 0.0) / totalEnergy) > tolerance)) {
+		double sigma = singularValues.at<double>(rank);
+		double sqrtSigma = sqrt(sigma);
+
+		SeparableTerm term;
+		term.column = u.col(rank) * sqrtSigma;
+		term.row = vt.row(rank) * sqrtSigma;
+		terms.push_back(term);
+
+		remainingEnergy -= sigma * sigma;
+		rank++;
+	}
+	relativeError = totalEnergy == 0 ? 0 : sqrt(max(remainingEnergy, 0.0) / totalEnergy);
+
+	// Najveca moguca greska izlaznog piksela (ulaz u opsegu 0-255) je 255 * L1 norma ostatka
+	Mat approximation = Mat::zeros(kernel.rows, kernel.cols, CV_64F);
+	for (size_t i = 0; i < terms.size(); i++) {
+		approximation += terms[i].column * terms[i].row;
+	}
+	maxOutputError = 255.0 * norm(kernel, approximation, NORM_L1);
+}
+
+const vector<SeparableTerm>& KernelDecomposition::getTerms()
+{
+	return terms;
+}
+
+int KernelDecomposition::getRank()
+{
+	return (int)terms.size();
+}
+
+int KernelDecomposition::getFullRank()
+{
+	return fullRank;
+}
+
+bool KernelDecomposition::isExact()
+{
+	return getRank() == fullRank;
+}
+
+double KernelDecomposition::getRelativeError()
+{
+	return relativeError;
+}
+
+double KernelDecomposition::getMaxOutputError()
+{
+	return maxOutputError;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+// Jedan separabilni clan: kernel ~ column * row (column je K x 1, row je 1 x K, oba CV_64F)
+struct SeparableTerm
+{
+    Mat column;
+    Mat row;
+};
+
+// Rastavljanje kernela na sumu separabilnih clanova pomocu SVD-a.
+// Zadrzava se najmanji broj clanova za koji je relativna greska (Frobenijusova norma ostatka
+// podijeljena normom kernela) manja ili jednaka zadatoj toleranciji.
+class KernelDecomposition
+{
+    vector<SeparableTerm> terms;
+    int fullRank;
+    double relativeError;
+    double maxOutputError;
+
+public:
+    KernelDecomposition(Mat kernel, double tolerance);
+    const vector<SeparableTerm>& getTerms();
+    int getRank();
+    int getFullRank();
+    bool isExact();
+    double getRelativeError();
+    double getMaxOutputError();
+};
@@ -0,0 +1,129 @@
+#include "KernelProgram.h"
+#include <stdexcept>
+#include <cstdio>
+#include <algorithm>
+
+// 1 ako je kernel jednak svom odrazu, -1 ako je jednak negativnom odrazu, 0 inace;
+// odraz je lijevo-desno, gore-dolje ili oba (centralna simetrija)
+static int mirrorSymmetry(const Mat& kernel, bool flipRows, bool flipCols)
+{
+	bool symmetric = true;
+	bool antisymmetric = true;
+	for (int u = 0; u < kernel.rows; u++) {
+		for (int v = 0; v < kernel.cols; v++) {
+			double value = kernel.at<double>(u, v);
+			double mirrored = kernel.at<double>(flipRows ? kernel.rows - 1 - u : u, flipCols ? kernel.cols - 1 - v : v);
+			symmetric = symmetric && value == mirrored;
+			antisymmetric = antisymmetric && value == -mirrored;
+		}
+	}
+	return symmetric ? 1 : (antisymmetric ? -1 : 0);
+}
+
+KernelProgram::KernelProgram()
+{
+	denseTaps = 0;
+	groupStarts.push_back(0);
+}
+
+void KernelProgram::compile(const Mat& kernel, bool grouped)
+{
+	if (kernel.empty() || kernel.type() != CV_64F) {
+		throw invalid_argument("Kernel mora biti neprazna CV_64F matrica");
+	}
+	int kernelRowsSizeHalf = kernel.rows / 2;
+	int kernelColsSizeHalf = kernel.cols / 2;
+	denseTaps = kernel.rows * kernel.cols;
+	weights.clear();
+	groupStarts.assign(1, 0);
+	negativeStarts.clear();
+	tapRows.clear();
+	tapCols.clear();
+
+	if (!grouped) {
+		for (int u = 0; u < kernel.rows; u++) {
+			for (int v = 0; v < kernel.cols; v++) {
+				weights.push_back(kernel.at<double>(u, v));
+				tapRows.push_back(u - kernelRowsSizeHalf);
+				tapCols.push_back(v - kernelColsSizeHalf);
+				negativeStarts.push_back((int)tapRows.size());
+				groupStarts.push_back((int)tapRows.size());
+			}
+		}
+		symmetry = "";
+		return;
+	}
+
+	// Grupe redom po prvom pojavljivanju apsolutne vrijednosti; tezina grupe ima znak njenog prvog
+	// tapa, pa se tapovi istog znaka sabiraju, a suprotnog oduzimaju
+	vector<bool> assigned(denseTaps, false);
+	for (int first = 0; first < denseTaps; first++) {
+		double weight = kernel.at<double>(first / kernel.cols, first % kernel.cols);
+		if (assigned[first] || weight == 0) {
+			continue;
+		}
+		weights.push_back(weight);
+		for (int sign = 1; sign >= -1; sign -= 2) {
+			if (sign < 0) {
+				negativeStarts.push_back((int)tapRows.size());
+			}
+			for (int tap = first; tap < denseTaps; tap++) {
+				if (!assigned[tap] && kernel.at<double>(tap / kernel.cols, tap % kernel.cols) == sign * weight) {
+					assigned[tap] = true;
+					tapRows.push_back(tap / kernel.cols - kernelRowsSizeHalf);
+					tapCols.push_back(tap % kernel.cols - kernelColsSizeHalf);
+				}
+			}
+		}
+		groupStarts.push_back((int)tapRows.size());
+	}
+
+	const char* names[] = { "lijevo-desno", "gore-dolje", "centralna" };
+	const bool flips[][2] = { { false, true }, { true, false }, { true, true } };
+	symmetry = "";
+	for (int i = 0; i < 3; i++) {
+		int found = mirrorSymmetry(kernel, flips[i][0], flips[i][1]);
+		if (found != 0) {
+			symmetry += String(symmetry.empty() ? "" : ", ") + names[i] + (found > 0 ? "" : " (anti)");
+		}
+	}
+}
+
+int KernelProgram::getGroupCount() const
+{
+	return (int)weights.size();
+}
+
+int KernelProgram::getTapCount() const
+{
+	return (int)tapRows.size();
+}
+
+int KernelProgram::getDenseTapCount() const
+{
+	return denseTaps;
+}
+
+String KernelProgram::describe() const
+{
+	// Po kanalu: jedno mnozenje po grupi; sabiranja su tapovi unutar grupa plus zbir grupa, bez prvog
+	int multiplications = getGroupCount();
+	int additions = max(getTapCount() - 1, 0);
+	int denseOperations = 2 * denseTaps - 1;
+	if (getTapCount() == 0) {
+		return "nulti kernel, bez operacija";
+	}
+	if (getTapCount() == denseTaps && multiplications == denseTaps) {
+		return "gusti kernel, " + to_string(denseTaps) + " tapova: " + to_string(denseTaps) + " mnozenja i " + to_string(denseTaps - 1) + " sabiranja po kanalu";
+	}
+
+	char ratio[32];
+	snprintf(ratio, sizeof(ratio), "%.2f", denseOperations / (double)(multiplications + additions));
+	String description = to_string(getTapCount()) + " od " + to_string(denseTaps) + " tapova (grupa: " + to_string(getGroupCount()) + "): ";
+	description += to_string(multiplications) + " mnozenja i " + to_string(additions) + " sabiranja po kanalu umjesto ";
+	description += to_string(denseTaps) + " i " + to_string(denseTaps - 1) + " (" + ratio + "x manje operacija)";
+	if (!symmetry.empty()) {
+		description += ", simetrija: " + symmetry;
+	}
+	return description;
+}
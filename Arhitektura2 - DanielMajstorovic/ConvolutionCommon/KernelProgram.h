@@ -0,0 +1,63 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+// Kernel preveden u program tapova: bez nula, tapovi iste apsolutne vrijednosti se saberu (ili oduzmu) pa
+// pomnoze jednom (Sobel 3 x 3: 5 sabiranja i 2 mnozenja). compile(kernel, false) racuna kao gusta petlja.
+class KernelProgram
+{
+    vector<double> weights;
+    // Tapovi grupe g su [groupStarts[g], groupStarts[g + 1]), od negativeStarts[g] se oduzimaju
+    vector<int> groupStarts;
+    vector<int> negativeStarts;
+    // Pomak tapa od centra kernela
+    vector<int> tapRows;
+    vector<int> tapCols;
+    int denseTaps;
+    String symmetry;
+
+public:
+    KernelProgram();
+    void compile(const Mat& kernel, bool grouped);
+    int getGroupCount() const;
+    int getTapCount() const;
+    int getDenseTapCount() const;
+    // Broj tapova, mnozenja i sabiranja po kanalu u odnosu na gusti kernel, i pronadjene simetrije
+    String describe() const;
+
+    double getWeight(int group) const { return weights[group]; }
+    int getGroupStart(int group) const { return groupStarts[group]; }
+    int getNegativeStart(int group) const { return negativeStarts[group]; }
+    int getTapRow(int tap) const { return tapRows[tap]; }
+    int getTapCol(int tap) const { return tapCols[tap]; }
+
+    // Rezultat za centar kernela (x, y) slike CV_8UC3; cijeli kernel mora lezati u slici
+    Vec3d apply(const Mat& image, int x, int y) const
+    {
+        double r = 0, g = 0, b = 0;
+        int groups = (int)weights.size();
+        for (int group = 0; group < groups; group++) {
+            int sumR = 0, sumG = 0, sumB = 0;
+            int tap = groupStarts[group];
+            for (; tap < negativeStarts[group]; tap++) {
+                const Vec3b& pixel = image.at<Vec3b>(x + tapRows[tap], y + tapCols[tap]);
+                sumR += pixel[0];
+                sumG += pixel[1];
+                sumB += pixel[2];
+            }
+            for (; tap < groupStarts[group + 1]; tap++) {
+                const Vec3b& pixel = image.at<Vec3b>(x + tapRows[tap], y + tapCols[tap]);
+                sumR -= pixel[0];
+                sumG -= pixel[1];
+                sumB -= pixel[2];
+            }
+            r += sumR * weights[group];
+            g += sumG * weights[group];
+            b += sumB * weights[group];
+        }
+        return Vec3d(r, g, b);
+    }
+};
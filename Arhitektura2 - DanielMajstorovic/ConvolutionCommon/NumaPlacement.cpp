@@ -0,0 +1,392 @@
+#include "NumaPlacement.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <sstream>
+#endif
+
+static atomic<int> affinityPolicy(AffinityNone);
+// Procesori dozvoljeni procesu; citaju se jednom, prije nego sto se ijedna nit veze
+static mutex allowedCpusMutex;
+static vector<int> allowedCpus;
+static bool allowedCpusReady = false;
+
+NumaPlacement parseNumaPlacement(const string& name)
+{
+	if (name == "aware") {
+		return NumaAware;
+	}
+	if (name == "naive") {
+		return NumaNaive;
+	}
+	throw invalid_argument("Opcija --numa mora biti aware ili naive");
+}
+
+string getNumaPlacementName(NumaPlacement placement)
+{
+	return placement == NumaAware ? "aware" : "naive";
+}
+
+HugePages parseHugePages(const string& name)
+{
+	if (name == "off") {
+		return HugePagesOff;
+	}
+	if (name == "transparent") {
+		return HugePagesTransparent;
+	}
+	if (name == "explicit") {
+		return HugePagesExplicit;
+	}
+	throw invalid_argument("Opcija --hugepages mora biti off, transparent ili explicit");
+}
+
+string getHugePagesName(HugePages pages)
+{
+	switch (pages) {
+	case HugePagesTransparent: return "transparent";
+	case HugePagesExplicit: return "explicit";
+	default: return "off";
+	}
+}
+
+static string readAffinityEnvironment()
+{
+#ifdef _MSC_VER
+	char* value = nullptr;
+	size_t length = 0;
+	string result;
+	if (_dupenv_s(&value, &length, "CONV_AFFINITY") == 0 && value != nullptr) {
+		result = value;
+		free(value);
+	}
+	return result;
+#else
+	const char* value = getenv("CONV_AFFINITY");
+	return value != nullptr ? value : "";
+#endif
+}
+
+AffinityPolicy selectAffinityPolicy(const string& requested)
+{
+	string name = requested.empty() ? readAffinityEnvironment() : requested;
+	if (name.empty() || name == "none") {
+		return AffinityNone;
+	}
+	if (name == "compact") {
+		return AffinityCompact;
+	}
+	if (name == "scatter") {
+		return AffinityScatter;
+	}
+	throw invalid_argument("Opcija --affinity mora biti none, compact ili scatter");
+}
+
+string getAffinityPolicyName(AffinityPolicy policy)
+{
+	switch (policy) {
+	case AffinityCompact: return "compact";
+	case AffinityScatter: return "scatter";
+	default: return "none";
+	}
+}
+
+#ifndef _WIN32
+// Lista oblika "0-3,8-11" iz /sys
+static vector<int> parseCpuList(const string& text)
+{
+	vector<int> cpus;
+	stringstream stream(text);
+	string part;
+	while (getline(stream, part, ',')) {
+		if (part.empty()) {
+			continue;
+		}
+		size_t dash = part.find('-');
+		int first = stoi(part.substr(0, dash));
+		int last = dash == string::npos ? first : stoi(part.substr(dash + 1));
+		for (int cpu = first; cpu <= last; cpu++) {
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+#endif
+
+vector<vector<int>> detectNumaNodes()
+{
+	vector<vector<int>> nodes;
+#ifdef _WIN32
+	// Procesor je oznacen kao grupa x 64 + bit u maski grupe
+	ULONG highestNode = 0;
+	if (GetNumaHighestNodeNumber(&highestNode)) {
+		for (USHORT node = 0; node <= highestNode; node++) {
+			GROUP_AFFINITY affinity;
+			if (!GetNumaNodeProcessorMaskEx(node, &affinity) || affinity.Mask == 0) {
+				continue;
+			}
+			vector<int> cpus;
+			for (int bit = 0; bit < 64; bit++) {
+				if (affinity.Mask & ((KAFFINITY)1 << bit)) {
+					cpus.push_back(affinity.Group * 64 + bit);
+				}
+			}
+			nodes.push_back(cpus);
+		}
+	}
+#else
+	for (int node = 0; node < 1024; node++) {
+		ifstream cpuList("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+		string text;
+		if (!cpuList.is_open()) {
+			// Brojevi cvorova mogu imati praznine, ali ne na pocetku
+			if (node > 0 && nodes.empty()) {
+				break;
+			}
+			continue;
+		}
+		if (getline(cpuList, text)) {
+			vector<int> cpus = parseCpuList(text);
+			if (!cpus.empty()) {
+				nodes.push_back(cpus);
+			}
+		}
+	}
+#endif
+	if (nodes.empty()) {
+		vector<int> cpus;
+		int count = max((int)thread::hardware_concurrency(), 1);
+		for (int cpu = 0; cpu < count; cpu++) {
+			cpus.push_back(cpu);
+		}
+		nodes.push_back(cpus);
+	}
+	return nodes;
+}
+
+void setAffinityPolicy(AffinityPolicy policy)
+{
+	affinityPolicy = policy;
+}
+
+AffinityPolicy getAffinityPolicy()
+{
+	return (AffinityPolicy)affinityPolicy.load();
+}
+
+// Maska procesa; prazna lista kada se ne moze procitati
+static vector<int> readProcessCpus()
+{
+	vector<int> cpus;
+#ifdef _WIN32
+	// Maska procesa pokriva samo njegovu grupu procesora, pa se koristi samo kada je grupa jedna
+	DWORD_PTR processMask = 0, systemMask = 0;
+	if (GetActiveProcessorGroupCount() == 1 && GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+		for (int bit = 0; bit < (int)sizeof(DWORD_PTR) * 8; bit++) {
+			if (processMask & ((DWORD_PTR)1 << bit)) {
+				cpus.push_back(bit);
+			}
+		}
+	}
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &set)) {
+				cpus.push_back(cpu);
+			}
+		}
+	}
+#endif
+	return cpus;
+}
+
+// Redoslijed procesora: compact ide cvor po cvor, scatter uzima po jedan iz svakog cvora redom;
+// procesori van maske procesa se preskacu
+static vector<int> buildAffinityOrder(AffinityPolicy policy)
+{
+	static const vector<vector<int>> nodes = detectNumaNodes();
+	vector<int> allowed;
+	{
+		lock_guard<mutex> lock(allowedCpusMutex);
+		if (!allowedCpusReady) {
+			allowedCpus = readProcessCpus();
+			allowedCpusReady = true;
+		}
+		allowed = allowedCpus;
+	}
+	vector<vector<int>> allowedNodes;
+	for (const vector<int>& node : nodes) {
+		vector<int> cpus;
+		for (int cpu : node) {
+			if (allowed.empty() || find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+				cpus.push_back(cpu);
+			}
+		}
+		if (!cpus.empty()) {
+			allowedNodes.push_back(cpus);
+		}
+	}
+	// Topologija i maska se ne poklapaju (npr. procesori van /sys liste): vazi maska
+	if (allowedNodes.empty()) {
+		allowedNodes.push_back(allowed);
+	}
+
+	vector<int> order;
+	if (policy == AffinityScatter) {
+		size_t largest = 0;
+		for (const vector<int>& node : allowedNodes) {
+			largest = max(largest, node.size());
+		}
+		for (size_t position = 0; position < largest; position++) {
+			for (const vector<int>& node : allowedNodes) {
+				if (position < node.size()) {
+					order.push_back(node[position]);
+				}
+			}
+		}
+	}
+	else {
+		for (const vector<int>& node : allowedNodes) {
+			order.insert(order.end(), node.begin(), node.end());
+		}
+	}
+	return order;
+}
+
+bool pinCurrentThread(int threadIndex)
+{
+	AffinityPolicy policy = getAffinityPolicy();
+	if (policy == AffinityNone) {
+		return false;
+	}
+	vector<int> order = buildAffinityOrder(policy);
+	if (order.empty()) {
+		return false;
+	}
+	int cpu = order[threadIndex % order.size()];
+
+#ifdef _WIN32
+	GROUP_AFFINITY affinity;
+	memset(&affinity, 0, sizeof(affinity));
+	affinity.Group = (WORD)(cpu / 64);
+	affinity.Mask = (KAFFINITY)1 << (cpu % 64);
+	return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+vector<vector<int>> splitAffinityCpus(int parts)
+{
+	// Bez politike dijelovi idu cvor po cvor, kao compact
+	AffinityPolicy policy = getAffinityPolicy();
+	vector<int> order = buildAffinityOrder(policy == AffinityNone ? AffinityCompact : policy);
+	vector<vector<int>> shares(max(parts, 0));
+	int count = (int)order.size();
+	for (int part = 0; part < parts && count > 0; part++) {
+		int first = (int)((long long)part * count / parts);
+		int last = max((int)((long long)(part + 1) * count / parts), first + 1);
+		shares[part].assign(order.begin() + first, order.begin() + last);
+	}
+	return shares;
+}
+
+bool restrictAffinity(const vector<int>& cpus)
+{
+	if (cpus.empty()) {
+		return false;
+	}
+	{
+		lock_guard<mutex> lock(allowedCpusMutex);
+		allowedCpus = cpus;
+		allowedCpusReady = true;
+	}
+#ifdef _WIN32
+	// Samo za niti koje se vezuju nakon poziva; maska procesa ostaje
+	return true;
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int cpu : cpus) {
+		CPU_SET(cpu, &set);
+	}
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#endif
+}
+
+// Memorija direktno od operativnog sistema: poravnata na stranicu i jos nedodirnuta, pa first touch
+// odredjuje cvor; velike stranice po zahtjevu
+static shared_ptr<void> allocatePages(size_t bytes, HugePages pages)
+{
+#ifdef _WIN32
+	if (pages == HugePagesExplicit) {
+		SIZE_T largePage = GetLargePageMinimum();
+		if (largePage > 0) {
+			SIZE_T rounded = (bytes + largePage - 1) / largePage * largePage;
+			void* memory = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (memory != nullptr) {
+				return shared_ptr<void>(memory, [](void* address) { VirtualFree(address, 0, MEM_RELEASE); });
+			}
+		}
+	}
+	void* memory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (memory == nullptr) {
+		throw bad_alloc();
+	}
+	return shared_ptr<void>(memory, [](void* address) { VirtualFree(address, 0, MEM_RELEASE); });
+#else
+	const size_t hugePage = 2 * 1024 * 1024;
+	if (pages == HugePagesExplicit) {
+		size_t rounded = (bytes + hugePage - 1) / hugePage * hugePage;
+		void* memory = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (memory != MAP_FAILED) {
+			return shared_ptr<void>(memory, [rounded](void* address) { munmap(address, rounded); });
+		}
+	}
+	void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (memory == MAP_FAILED) {
+		throw bad_alloc();
+	}
+#ifdef MADV_HUGEPAGE
+	if (pages != HugePagesOff) {
+		madvise(memory, bytes, MADV_HUGEPAGE);
+	}
+#endif
+	return shared_ptr<void>(memory, [bytes](void* address) { munmap(address, bytes); });
+#endif
+}
+
+Mat allocatePlacedImage(int rows, int cols, int type, NumaPlacement placement, HugePages pages, shared_ptr<void>& memory)
+{
+	size_t rowBytes = (size_t)cols * CV_ELEM_SIZE(type);
+	memory = allocatePages(max<size_t>(rowBytes * rows, 1), pages);
+	Mat image(rows, cols, type, memory.get());
+
+	if (placement == NumaAware) {
+		forEachIndex(rows, true, [&](int x) {
+			memset(image.ptr<uchar>(x), 0, rowBytes);
+		});
+	}
+	else {
+		memset(image.data, 0, rowBytes * rows);
+	}
+	return image;
+}
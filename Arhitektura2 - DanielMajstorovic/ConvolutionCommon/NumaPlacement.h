@@ -0,0 +1,70 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+// Smjestanje bafera slike u memoriju (--numa=aware|naive). Stranica zavrsava na NUMA cvoru niti koja
+// je prva upise (first touch):
+//  - NumaAware: svaku grupu redova prvi upisuje nit skupa koja ce je i racunati (ista pocetna podjela
+//    redova kao forEachIndex i forEachTile), pa svaka nit cita i pise lokalnu memoriju
+//  - NumaNaive: cijeli bafer nulira pozivajuca nit, kao nekadasnja sekvencijalna petlja prosirenja,
+//    pa je sva memorija na jednom cvoru
+enum NumaPlacement
+{
+    NumaNaive,
+    NumaAware
+};
+
+NumaPlacement parseNumaPlacement(const string& name);
+string getNumaPlacementName(NumaPlacement placement);
+
+// Velike stranice za bafere (--hugepages=off|transparent|explicit). Transparent trazi od jezgra da
+// bafer pokrije stranicama od 2 MB kada moze (Linux madvise); explicit ih rezervise direktno (Linux
+// MAP_HUGETLB, Windows MEM_LARGE_PAGES uz privilegiju zakljucavanja memorije), a ako nisu dostupne
+// koristi transparent, odnosno obicne stranice.
+enum HugePages
+{
+    HugePagesOff,
+    HugePagesTransparent,
+    HugePagesExplicit
+};
+
+HugePages parseHugePages(const string& name);
+string getHugePagesName(HugePages pages);
+
+// Vezivanje niti skupa za logicke procesore (--affinity=none|compact|scatter):
+//  - AffinityCompact: niti popunjavaju jedan NUMA cvor pa sljedeci (dijele L3 i memoriju)
+//  - AffinityScatter: niti se naizmjenicno dijele po cvorovima (vise memorijskih kanala)
+enum AffinityPolicy
+{
+    AffinityNone,
+    AffinityCompact,
+    AffinityScatter
+};
+
+// Politika zadata kao none, compact ili scatter; bez nje se koristi promjenljiva okruzenja CONV_AFFINITY
+AffinityPolicy selectAffinityPolicy(const string& requested);
+string getAffinityPolicyName(AffinityPolicy policy);
+
+// Logicki procesori po NUMA cvorovima; jedan cvor sa svim procesorima kada topologija nije poznata
+vector<vector<int>> detectNumaNodes();
+
+// Politika vazi za niti skupa napravljene nakon poziva, pa se zadaje prije prvog paralelnog poziva
+void setAffinityPolicy(AffinityPolicy policy);
+AffinityPolicy getAffinityPolicy();
+// Vezuje tekucu nit (indeks u skupu niti) prema politici; false kada politika nije zadata ili nije uspjelo.
+// Koriste se samo procesori iz maske procesa (sched_getaffinity pri prvom pozivu, ili restrictAffinity).
+bool pinCurrentThread(int threadIndex);
+// Dozvoljeni procesori redom politike, podijeljeni u parts disjunktnih dijelova (po jedan za radni proces);
+// kada procesora ima manje od dijelova, dio dobija jedan procesor
+vector<vector<int>> splitAffinityCpus(int parts);
+// Ogranicava proces na cpus; niti skupa napravljene nakon poziva vezuju se samo unutar njih
+bool restrictAffinity(const vector<int>& cpus);
+
+// Kontinualan bafer rows x cols tipa type, poravnat na stranicu i nuliran prema placement. Mat ne
+// posjeduje memoriju: ona traje dok postoji memory (ili neka njegova kopija).
+Mat allocatePlacedImage(int rows, int cols, int type, NumaPlacement placement, HugePages pages, shared_ptr<void>& memory);
@@ -0,0 +1,98 @@
+#include "PerfEvents.h"
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cpuid.h>
+#include <cstring>
+#endif
+
+#ifdef __linux__
+int openPerfCounter(unsigned int type, unsigned long long config)
+{
+	perf_event_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.size = sizeof(attributes);
+	attributes.type = type;
+	attributes.config = config;
+	attributes.disabled = 1;
+	attributes.inherit = 1;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+unsigned long long perfCacheReadMiss(unsigned long long cache)
+{
+	return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+std::string readCpuVendor()
+{
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+		return "";
+	}
+	char vendor[13];
+	memcpy(vendor, &ebx, 4);
+	memcpy(vendor + 4, &edx, 4);
+	memcpy(vendor + 8, &ecx, 4);
+	vendor[12] = 0;
+	return vendor;
+}
+#endif
+
+void startPerfCounters(const int* descriptors, int count)
+{
+#ifdef __linux__
+	for (int i = 0; i < count; i++) {
+		if (descriptors[i] >= 0) {
+			ioctl(descriptors[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+void stopPerfCounters(const int* descriptors, long long* values, int count)
+{
+	for (int i = 0; i < count; i++) {
+		values[i] = -1;
+	}
+#ifdef __linux__
+	// Prvo se iskljucuju svi, da citanje jednog ne ulazi u vrijednost drugog
+	for (int i = 0; i < count; i++) {
+		if (descriptors[i] >= 0) {
+			ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	for (int i = 0; i < count; i++) {
+		if (descriptors[i] < 0) {
+			continue;
+		}
+		// Vrijednost, vrijeme ukljucenosti i vrijeme stvarnog brojanja (zbog smjenjivanja brojaca)
+		unsigned long long data[3] = { 0, 0, 0 };
+		if (read(descriptors[i], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+			continue;
+		}
+		if (data[2] == 0) {
+			values[i] = data[1] == 0 ? 0 : -1;
+		}
+		else {
+			values[i] = (long long)((double)data[0] * data[1] / data[2]);
+		}
+	}
+#endif
+}
+
+void closePerfCounters(const int* descriptors, int count)
+{
+#ifdef __linux__
+	for (int i = 0; i < count; i++) {
+		if (descriptors[i] >= 0) {
+			close(descriptors[i]);
+		}
+	}
+#endif
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#endif
+
+// Zajednicki dio CacheMissCounters i PerformanceCounters. Brojac se otvara perf_event_open za tekuci
+// proces sa nasljedjivanjem na niti i cita zajedno sa vremenima ukljucenosti i stvarnog brojanja, pa se
+// vrijednost skalira kada kernel smjenjuje brojace. Na ostalim sistemima nijedan brojac nije otvoren.
+#ifdef __linux__
+int openPerfCounter(unsigned int type, unsigned long long config);
+// Konfiguracija PERF_TYPE_HW_CACHE dogadjaja za promasaje pri citanju iz kesa cache
+unsigned long long perfCacheReadMiss(unsigned long long cache);
+// Proizvodjac procesora iz CPUID (GenuineIntel, AuthenticAMD, ...); prazan tekst ako nije poznat
+std::string readCpuVendor();
+#endif
+
+// Nuliraju i ukljucuju, odnosno iskljucuju i citaju otvorene brojace (deskriptor >= 0); vrijednost
+// neotvorenog ili neprocitanog brojaca je -1
+void startPerfCounters(const int* descriptors, int count);
+void stopPerfCounters(const int* descriptors, long long* values, int count);
+void closePerfCounters(const int* descriptors, int count);
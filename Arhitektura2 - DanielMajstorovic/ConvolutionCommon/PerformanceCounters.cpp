@@ -0,0 +1,92 @@
+#include "PerformanceCounters.h"
+#include "PerfEvents.h"
+
+PerformanceCounters::PerformanceCounters()
+{
+	for (int i = 0; i < CounterCount; i++) {
+		descriptors[i] = -1;
+		values[i] = -1;
+		floatingPointWeights[i] = 0;
+	}
+#ifdef __linux__
+	descriptors[CycleCounter] = openPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	descriptors[InstructionCounter] = openPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	descriptors[L1Counter] = openPerfCounter(PERF_TYPE_HW_CACHE, perfCacheReadMiss(PERF_COUNT_HW_CACHE_L1D));
+	descriptors[LastLevelCounter] = openPerfCounter(PERF_TYPE_HW_CACHE, perfCacheReadMiss(PERF_COUNT_HW_CACHE_LL));
+	if (descriptors[LastLevelCounter] < 0) {
+		descriptors[LastLevelCounter] = openPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	}
+
+	std::string vendor = readCpuVendor();
+	if (vendor == "GenuineIntel") {
+		// FP_ARITH_INST_RETIRED (0xC7): umask bira sirinu i tip, tezina je broj elemenata u registru
+		const int umasks[7] = { 0x03, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+		const int weights[7] = { 1, 2, 4, 4, 8, 8, 16 };
+		for (int i = 0; i < 7; i++) {
+			descriptors[FirstFloatingPointCounter + i] = openPerfCounter(PERF_TYPE_RAW, (unsigned long long)(umasks[i] << 8 | 0xC7));
+			floatingPointWeights[FirstFloatingPointCounter + i] = weights[i];
+		}
+	}
+	else if (vendor == "AuthenticAMD") {
+		descriptors[FirstFloatingPointCounter] = openPerfCounter(PERF_TYPE_RAW, 0xFF03);
+		floatingPointWeights[FirstFloatingPointCounter] = 1;
+	}
+#endif
+}
+
+PerformanceCounters::~PerformanceCounters()
+{
+	closePerfCounters(descriptors, CounterCount);
+}
+
+bool PerformanceCounters::isAvailable()
+{
+	return descriptors[CycleCounter] >= 0 || descriptors[InstructionCounter] >= 0 || descriptors[LastLevelCounter] >= 0;
+}
+
+void PerformanceCounters::start()
+{
+	startPerfCounters(descriptors, CounterCount);
+}
+
+void PerformanceCounters::stop()
+{
+	stopPerfCounters(descriptors, values, CounterCount);
+}
+
+long long PerformanceCounters::getCycles()
+{
+	return values[CycleCounter];
+}
+
+long long PerformanceCounters::getInstructions()
+{
+	return values[InstructionCounter];
+}
+
+long long PerformanceCounters::getL1Misses()
+{
+	return values[L1Counter];
+}
+
+long long PerformanceCounters::getLastLevelMisses()
+{
+	return values[LastLevelCounter];
+}
+
+long long PerformanceCounters::getFloatingPointOperations()
+{
+	long long total = 0;
+	bool counted = false;
+	for (int i = FirstFloatingPointCounter; i < CounterCount; i++) {
+		if (descriptors[i] < 0) {
+			continue;
+		}
+		if (values[i] < 0) {
+			return -1;
+		}
+		total += values[i] * floatingPointWeights[i];
+		counted = true;
+	}
+	return counted ? total : -1;
+}
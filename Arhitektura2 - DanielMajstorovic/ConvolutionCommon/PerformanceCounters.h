@@ -0,0 +1,31 @@
+#pragma once
+
+// Hardverski brojaci za jedno mjereno izvrsavanje: ciklusi, instrukcije, promasaji L1D i posljednjeg
+// nivoa kesa i operacije u pokretnom zarezu. Kao i CacheMissCounters, na Linuxu koristi
+// perf_event_open sa nasljedjivanjem na niti, pa objekat treba napraviti prije prvog paralelnog
+// poziva (prije nego sto nastanu niti skupa). FP operacije nemaju generican dogadjaj:
+//  - Intel: FP_ARITH_INST_RETIRED po sirini (skalar, 128, 256, 512 bita, double i float), pomnozeno
+//    brojem elemenata; FMA se u tim dogadjajima vec broji dvostruko,
+//  - AMD: RETIRED_SSE_AVX_FLOPS, koji direktno broji operacije.
+// Brojaca ima vise nego hardverskih registara, pa ih kernel smjenjuje; vrijednosti se skaliraju
+// odnosom vremena ukljucenosti i stvarnog brojanja. Nedostupan brojac vraca -1.
+class PerformanceCounters
+{
+    enum { CycleCounter, InstructionCounter, L1Counter, LastLevelCounter, FirstFloatingPointCounter, CounterCount = FirstFloatingPointCounter + 7 };
+
+    int descriptors[CounterCount];
+    long long values[CounterCount];
+    int floatingPointWeights[CounterCount];
+
+public:
+    PerformanceCounters();
+    ~PerformanceCounters();
+    bool isAvailable();
+    void start();
+    void stop();
+    long long getCycles();
+    long long getInstructions();
+    long long getL1Misses();
+    long long getLastLevelMisses();
+    long long getFloatingPointOperations();
+};
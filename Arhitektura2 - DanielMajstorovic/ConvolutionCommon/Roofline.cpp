@@ -0,0 +1,105 @@
+#include "Roofline.h"
+#include "CacheInfo.h"
+#include "CpuFeatures.h"
+#include "WorkStealingPool.h"
+#include <omp.h>
+#include <vector>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fstream>
+#include <string>
+#endif
+
+// Nominalna frekvencija jezgra u Hz
+static double detectFrequency()
+{
+	double megahertz = 0;
+#ifdef _WIN32
+	DWORD value = 0;
+	DWORD size = sizeof(value);
+	if (RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0", "~MHz", RRF_RT_REG_DWORD, nullptr, &value, &size) == ERROR_SUCCESS) {
+		megahertz = value;
+	}
+#else
+	std::ifstream maxFrequency("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
+	double kilohertz = 0;
+	if (maxFrequency >> kilohertz) {
+		megahertz = kilohertz / 1000;
+	}
+	else {
+		std::ifstream cpuInfo("/proc/cpuinfo");
+		std::string line;
+		while (std::getline(cpuInfo, line)) {
+			if (line.compare(0, 7, "cpu MHz") == 0 && line.find(':') != std::string::npos) {
+				megahertz = std::stod(line.substr(line.find(':') + 1));
+				break;
+			}
+		}
+	}
+#endif
+	return megahertz > 0 ? megahertz * 1e6 : 3e9;
+}
+
+// Double operacije po ciklusu: sirina registra x 2 (FMA) x 2 jedinice; bez FMA posebno sabiranje i mnozenje
+static double flopsPerCycle(IsaLevel isa)
+{
+	switch (isa) {
+	case IsaAvx512: return 32;
+	case IsaAvx2: return 16;
+	case IsaSse41: return 4;
+	default: return 2;
+	}
+}
+
+static double measureTriadBandwidth(bool parallel)
+{
+	// Tri niza ukupno bar 4 x LLC (najmanje 96 MB), obradjena u dijelovima od po 64K elemenata
+	CacheSizes caches = detectCacheSizes();
+	size_t totalBytes = std::max<size_t>(4 * caches.l3, 96 * 1024 * 1024);
+	const int chunk = 64 * 1024;
+	int chunks = (int)(totalBytes / (3 * sizeof(double)) / chunk);
+	size_t length = (size_t)chunks * chunk;
+	std::vector<double> a(length), b(length, 1.0), c(length, 2.0);
+	double scalar = 3.0;
+
+	double best = 0;
+	for (int repetition = 0; repetition < 4; repetition++) {
+		double start = omp_get_wtime();
+		forEachIndex(chunks, parallel, [&](int k) {
+			size_t begin = (size_t)k * chunk;
+			for (size_t i = begin; i < begin + chunk; i++) {
+				a[i] = b[i] + scalar * c[i];
+			}
+		});
+		double seconds = omp_get_wtime() - start;
+		// Prvi prolaz samo mapira stranice
+		if (repetition > 0) {
+			best = std::max(best, 3.0 * sizeof(double) * length / seconds / 1e9);
+		}
+	}
+	return best;
+}
+
+RooflinePeaks estimateRooflinePeaks(bool parallel)
+{
+	RooflinePeaks peaks;
+	peaks.threads = parallel ? omp_get_max_threads() : 1;
+	peaks.frequency = detectFrequency();
+	peaks.gflops = peaks.threads * peaks.frequency * flopsPerCycle(detectIsaLevel()) / 1e9;
+	peaks.bandwidth = measureTriadBandwidth(parallel);
+	return peaks;
+}
+
+RooflinePoint placeOnRoofline(double flops, double bytes, double seconds, const RooflinePeaks& peaks)
+{
+	RooflinePoint point;
+	point.intensity = bytes > 0 ? flops / bytes : 0;
+	point.gflops = flops / seconds / 1e9;
+	point.bandwidth = bytes / seconds / 1e9;
+	point.attainable = bytes > 0 ? std::min(peaks.gflops, point.intensity * peaks.bandwidth) : peaks.gflops;
+	// Tacka preloma: intenzitet pri kojem memorija prestaje biti ogranicenje
+	point.memoryBound = bytes > 0 && point.intensity < peaks.gflops / peaks.bandwidth;
+	return point;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// Granice roofline modela za sekvencijalno (jedna nit) ili paralelno izvrsavanje (sve niti skupa)
+struct RooflinePeaks
+{
+    int threads;
+    double frequency;
+    double gflops;
+    double bandwidth;
+};
+
+// Vrh racunanja: niti x frekvencija x FLOP po ciklusu za najsiri podrzani skup instrukcija (double,
+// dvije FMA jedinice). Frekvencija je nominalna, procitana iz operativnog sistema (3 GHz ako nije
+// dostupna). Propusni opseg se mjeri zbirom nizova a = b + s * c (STREAM triad) nad nizovima
+// nekoliko puta vecim od LLC, uz isti skup niti koji koriste varijante.
+RooflinePeaks estimateRooflinePeaks(bool parallel);
+
+// Polozaj jednog mjerenja: intenzitet (FLOP po bajtu prenesenom iz memorije), postignuti GFLOP/s i
+// GB/s, krov min(vrh racunanja, intenzitet x propusni opseg) i strana tacke preloma na kojoj se nalazi
+struct RooflinePoint
+{
+    double intensity;
+    double gflops;
+    double bandwidth;
+    double attainable;
+    bool memoryBound;
+};
+
+RooflinePoint placeOnRoofline(double flops, double bytes, double seconds, const RooflinePeaks& peaks);
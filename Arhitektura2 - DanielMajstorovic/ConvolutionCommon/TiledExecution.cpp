@@ -0,0 +1,42 @@
+#include "TiledExecution.h"
+#include "CacheInfo.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+TileShape chooseTileShape(int kernelRows, int kernelCols, int bytesPerPixel)
+{
+	static const CacheSizes caches = detectCacheSizes();
+	long long l1Budget = (long long)caches.l1 / 2;
+	long long l2Budget = (long long)caches.l2 / 2;
+
+	// Redovi kernela koji se ponovo koriste za susjedni izlazni red treba da ostanu u L1
+	long long cols = l1Budget / ((long long)kernelRows * bytesPerPixel) - (kernelCols - 1);
+	cols = std::max(16LL, std::min(cols, 4096LL));
+
+	// Cijeli ulazni blok (sa rubom) u L2, da susjedni blokovi ne istiskuju jedan drugog
+	long long rows = l2Budget / ((cols + kernelCols - 1) * bytesPerPixel) - (kernelRows - 1);
+	rows = std::max(8LL, std::min(rows, 4096LL));
+
+	TileShape tile = { (int)rows, (int)cols };
+	return tile;
+}
+
+void forEachTile(Rect region, TileShape tile, bool parallel, const function<void(Rect)>& tileFunction)
+{
+	// Slika manja od kernela nema unutrasnjost (prazan region)
+	if (region.width <= 0 || region.height <= 0) {
+		return;
+	}
+
+	int tilesDown = (region.height + tile.rows - 1) / tile.rows;
+	int tilesAcross = (region.width + tile.cols - 1) / tile.cols;
+	int tileCount = tilesDown * tilesAcross;
+
+	forEachIndex(tileCount, parallel, [&](int t) {
+		int top = region.y + (t / tilesAcross) * tile.rows;
+		int left = region.x + (t % tilesAcross) * tile.cols;
+		int height = std::min(tile.rows, region.y + region.height - top);
+		int width = std::min(tile.cols, region.x + region.width - left);
+		tileFunction(Rect(left, top, width, height));
+	});
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <functional>
+
+using namespace cv;
+using namespace std;
+
+// Dimenzije bloka izlazne slike (u pikselima) za blokovsko izvrsavanje konvolucije
+struct TileShape
+{
+    int rows;
+    int cols;
+};
+
+// Bira oblik bloka na osnovu velicine kernela i kesa: sirina tako da kernel.rows redova ulaza
+// sirine (cols + kernel.cols - 1) stane u pola L1, a visina tako da cio ulazni blok sa rubom
+// od pola kernela stane u pola L2. bytesPerPixel je velicina jednog piksela ulaza (npr. Vec3d).
+TileShape chooseTileShape(int kernelRows, int kernelCols, int bytesPerPixel);
+
+// Poziva tileFunction za svaki blok oblika tile unutar region (posljednji blokovi u redu/koloni
+// mogu biti manji). Kada je parallel true, blokovi se dijele nitima skupa sa kradjom posla.
+void forEachTile(Rect region, TileShape tile, bool parallel, const function<void(Rect)>& tileFunction);
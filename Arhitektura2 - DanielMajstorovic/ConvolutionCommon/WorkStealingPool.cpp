@@ -0,0 +1,206 @@
+#include "WorkStealingPool.h"
+#include "NumaPlacement.h"
+#include <omp.h>
+#include <algorithm>
+
+// Da li tekuca nit upravo izvrsava zadatak iz skupa (ugnijezdeni poziv ide sekvencijalno)
+static thread_local bool insidePool = false;
+
+// Postavlja insidePool za vrijeme zadataka i vraca ga i kada zadatak baci izuzetak
+struct InsidePoolScope
+{
+	bool previous;
+	InsidePoolScope() : previous(insidePool) { insidePool = true; }
+	~InsidePoolScope() { insidePool = previous; }
+};
+
+WorkStealingPool::WorkStealingPool()
+	: currentTask(nullptr), jobGeneration(0), finishedWorkers(0), stopping(false)
+{
+	int threadCount = max(omp_get_max_threads(), 1);
+	for (int i = 0; i < threadCount; i++) {
+		ranges.push_back(unique_ptr<WorkerRange>(new WorkerRange()));
+		ranges.back()->begin = ranges.back()->end = 0;
+	}
+	// Pozivajuca nit je nit 0 skupa, pa se i ona vezuje prema politici (--affinity)
+	pinCurrentThread(0);
+	for (int i = 1; i < threadCount; i++) {
+		workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		lock_guard<mutex> lock(stateMutex);
+		stopping = true;
+	}
+	jobAvailable.notify_all();
+	for (thread& worker : workers) {
+		worker.join();
+	}
+}
+
+WorkStealingPool& WorkStealingPool::getInstance()
+{
+	static WorkStealingPool pool;
+	return pool;
+}
+
+int WorkStealingPool::getThreadCount()
+{
+	return (int)ranges.size();
+}
+
+void WorkStealingPool::workerLoop(int worker)
+{
+	pinCurrentThread(worker);
+	long long seenGeneration = 0;
+	while (true) {
+		{
+			unique_lock<mutex> lock(stateMutex);
+			jobAvailable.wait(lock, [&]() { return stopping || jobGeneration != seenGeneration; });
+			if (stopping) {
+				return;
+			}
+			seenGeneration = jobGeneration;
+		}
+
+		runTasks(worker);
+
+		{
+			lock_guard<mutex> lock(stateMutex);
+			finishedWorkers++;
+		}
+		jobFinished.notify_all();
+	}
+}
+
+bool WorkStealingPool::takeTask(int worker, int& task)
+{
+	WorkerRange& range = *ranges[worker];
+	lock_guard<mutex> lock(range.lock);
+	if (range.begin >= range.end) {
+		return false;
+	}
+	task = range.begin++;
+	return true;
+}
+
+bool WorkStealingPool::stealTasks(int worker)
+{
+	int threadCount = (int)ranges.size();
+	for (int offset = 1; offset < threadCount; offset++) {
+		WorkerRange& victim = *ranges[(worker + offset) % threadCount];
+		int begin, end;
+		{
+			lock_guard<mutex> lock(victim.lock);
+			int available = victim.end - victim.begin;
+			if (available <= 0) {
+				continue;
+			}
+			// Druga polovina opsega (najmanje jedan zadatak) prelazi kradljivcu
+			end = victim.end;
+			begin = victim.end - (available + 1) / 2;
+			victim.end = begin;
+		}
+		WorkerRange& own = *ranges[worker];
+		lock_guard<mutex> lock(own.lock);
+		own.begin = begin;
+		own.end = end;
+		return true;
+	}
+	return false;
+}
+
+void WorkStealingPool::cancelTasks()
+{
+	for (unique_ptr<WorkerRange>& range : ranges) {
+		lock_guard<mutex> lock(range->lock);
+		range->end = range->begin;
+	}
+}
+
+void WorkStealingPool::runTasks(int worker)
+{
+	InsidePoolScope scope;
+	const function<void(int)>& task = *currentTask;
+	int index;
+	try {
+		while (true) {
+			if (takeTask(worker, index)) {
+				task(index);
+			}
+			else if (!stealTasks(worker)) {
+				// Nema sta da se ukrade; preostale zadatke vec izvrsavaju druge niti
+				break;
+			}
+		}
+	}
+	catch (...) {
+		// Izuzetak ne smije napustiti nit skupa (std::terminate); pamti se prvi, a ostali zadaci se odbacuju
+		{
+			lock_guard<mutex> lock(stateMutex);
+			if (!taskError) {
+				taskError = current_exception();
+			}
+		}
+		cancelTasks();
+	}
+}
+
+void WorkStealingPool::parallelFor(int taskCount, const function<void(int)>& task)
+{
+	if (taskCount <= 0) {
+		return;
+	}
+	if (insidePool || ranges.size() == 1 || taskCount == 1) {
+		for (int i = 0; i < taskCount; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	lock_guard<mutex> jobLock(jobMutex);
+
+	// Pocetna podjela: uzastopni opsezi jednake velicine
+	int threadCount = (int)ranges.size();
+	for (int i = 0; i < threadCount; i++) {
+		lock_guard<mutex> lock(ranges[i]->lock);
+		ranges[i]->begin = (int)((long long)taskCount * i / threadCount);
+		ranges[i]->end = (int)((long long)taskCount * (i + 1) / threadCount);
+	}
+	currentTask = &task;
+
+	{
+		lock_guard<mutex> lock(stateMutex);
+		finishedWorkers = 0;
+		taskError = nullptr;
+		jobGeneration++;
+	}
+	jobAvailable.notify_all();
+
+	runTasks(0);
+
+	// Svaka nit mora preuzeti i zavrsiti posao prije sljedeceg, pa nijedna ne ostaje sa starim zadatkom
+	unique_lock<mutex> lock(stateMutex);
+	jobFinished.wait(lock, [&]() { return finishedWorkers == (int)workers.size(); });
+	currentTask = nullptr;
+	if (taskError) {
+		exception_ptr error = taskError;
+		taskError = nullptr;
+		rethrow_exception(error);
+	}
+}
+
+void forEachIndex(int count, bool parallel, const function<void(int)>& body)
+{
+	if (parallel) {
+		WorkStealingPool::getInstance().parallelFor(count, body);
+	}
+	else {
+		for (int i = 0; i < count; i++) {
+			body(i);
+		}
+	}
+}
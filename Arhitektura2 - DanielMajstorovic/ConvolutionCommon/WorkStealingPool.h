@@ -0,0 +1,62 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <exception>
+
+using namespace std;
+
+// Trajni skup niti sa kradjom posla, zajednicki za sve varijante. Niti se prave pri prvom
+// koristenju (broj niti kao omp_get_max_threads(), pa vazi OMP_NUM_THREADS) i ostaju aktivne
+// izmedju poziva. Svaka nit dobija uzastopan opseg zadataka (zbog lokalnosti) i uzima ih od
+// pocetka; kada ostane bez posla, krade drugu polovinu opsega od druge niti. Nit koja poziva
+// parallelFor i sama radi kao nit 0. Poziv iz zadatka koji se vec izvrsava u skupu radi se
+// sekvencijalno, a istovremeni pozivi iz vise spoljnih niti se izvrsavaju jedan za drugim.
+// Uz politiku vezivanja (NumaPlacement.h) svaka nit, i nit koja je napravila skup, vezuje se pri
+// nastanku skupa za svoj procesor, pa pocetni opseg niti ostaje na istom NUMA cvoru.
+// Izuzetak iz zadatka (na bilo kojoj niti) prekida preostale zadatke i, nakon sto sve niti zavrse,
+// baca se iz parallelFor pozivajucoj niti.
+class WorkStealingPool
+{
+    struct WorkerRange
+    {
+        mutex lock;
+        int begin;
+        int end;
+    };
+
+    vector<thread> workers;
+    vector<unique_ptr<WorkerRange>> ranges;
+    const function<void(int)>* currentTask;
+    // Prvi izuzetak tekuceg posla, pod stateMutex
+    exception_ptr taskError;
+    mutex jobMutex;
+    mutex stateMutex;
+    condition_variable jobAvailable;
+    condition_variable jobFinished;
+    long long jobGeneration;
+    int finishedWorkers;
+    bool stopping;
+
+    WorkStealingPool();
+    void workerLoop(int worker);
+    void runTasks(int worker);
+    bool takeTask(int worker, int& task);
+    bool stealTasks(int worker);
+    void cancelTasks();
+
+public:
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    static WorkStealingPool& getInstance();
+    int getThreadCount();
+    // Poziva task(i) za i = 0 .. taskCount - 1 i vraca se kada se svi zavrse
+    void parallelFor(int taskCount, const function<void(int)>& task);
+};
+
+// Poziva body(i) za i = 0 .. count - 1, preko skupa niti kada je parallel true
+void forEachIndex(int count, bool parallel, const function<void(int)>& body);
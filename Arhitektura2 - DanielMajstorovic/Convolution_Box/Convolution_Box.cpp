@@ -0,0 +1,176 @@
+#include "Convolution_Box.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+
+Convolution_Box::Convolution_Box(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Box::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	integralImageReady = false;
+
+	stringstream sizes(arguments.getOption("box-sizes", "3,9,27,81"));
+	string size;
+	testSizes.clear();
+	while (getline(sizes, size, ',')) {
+		testSizes.push_back(stoi(size));
+		if (testSizes.back() < 1) {
+			throw invalid_argument("Velicine u opciji --box-sizes moraju biti bar 1");
+		}
+	}
+
+	// Konstantan kernel: svi koeficijenti jednaki prvom
+	coefficient = convolutionKernel.at<double>(0, 0);
+	constantKernel = true;
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			constantKernel = constantKernel && convolutionKernel.at<double>(u, v) == coefficient;
+		}
+	}
+
+	if (constantKernel) {
+		kernelDescription = "konstantan kernel " + to_string(convolutionKernel.rows) + " x " + to_string(convolutionKernel.cols) + ", koeficijent " + to_string(coefficient);
+	}
+	else {
+		kernelDescription = "kernel nije konstantan, direktna konvolucija";
+	}
+}
+
+void Convolution_Box::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Box::setInputImage(Mat image)
+{
+	inputImage = image;
+	integralImageReady = false;
+}
+
+void Convolution_Box::prepareIntegralImage(int padding, bool parallel)
+{
+	integralImage.compute(inputImage, padding, borderMode, parallel);
+	integralImageReady = true;
+}
+
+Mat Convolution_Box::filterBox(int size, double weight, bool parallel)
+{
+	if (!integralImageReady || integralImage.getPadding() < size / 2) {
+		prepareIntegralImage(size / 2, parallel);
+	}
+	// Novi bafer za svaki poziv, kao u convolve()
+	outputImage.release();
+	integralImage.filterBox(size, size, weight, outputImage, parallel);
+	return outputImage;
+}
+
+void Convolution_Box::directConvolution(bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int kernelRowsSizeHalf = convolutionKernel.rows / 2;
+	int kernelColsSizeHalf = convolutionKernel.cols / 2;
+
+	// Direktna K x K konvolucija za kernele koji nisu konstantni
+	outputImage = Mat(rows, cols, CV_8UC3);
+	forEachIndex(rows, parallel, [&](int x) {
+		uchar* destination = outputImage.ptr<uchar>(x);
+		for (int y = 0; y < cols; y++) {
+			double r = 0, g = 0, b = 0;
+			for (int u = 0; u < convolutionKernel.rows; u++) {
+				int sourceRow = mapBorderIndex(x + u - kernelRowsSizeHalf, rows, borderMode);
+				if (sourceRow < 0) {
+					continue;
+				}
+				const uchar* source = inputImage.ptr<uchar>(sourceRow);
+				for (int v = 0; v < convolutionKernel.cols; v++) {
+					int sourceCol = mapBorderIndex(y + v - kernelColsSizeHalf, cols, borderMode);
+					if (sourceCol < 0) {
+						continue;
+					}
+					double weight = convolutionKernel.at<double>(u, v);
+					const uchar* pixel = source + 3 * sourceCol;
+					r += pixel[0] * weight;
+					g += pixel[1] * weight;
+					b += pixel[2] * weight;
+				}
+			}
+			destination[3 * y] = saturate_cast<uchar>(r);
+			destination[3 * y + 1] = saturate_cast<uchar>(g);
+			destination[3 * y + 2] = saturate_cast<uchar>(b);
+		}
+	});
+}
+
+Mat Convolution_Box::convolve(bool parallel)
+{
+	if (!constantKernel) {
+		directConvolution(parallel);
+		return outputImage;
+	}
+
+	// Integralna slika se pravi samo za novu ulaznu sliku ili kada postojeca nije dovoljno prosirena
+	// za ovaj kernel; sire prosirenje (npr. iz filterBox) se zadrzava
+	int padding = max(convolutionKernel.rows, convolutionKernel.cols) / 2;
+	if (!integralImageReady || integralImage.getPadding() < padding) {
+		prepareIntegralImage(padding, parallel);
+	}
+	// Novi bafer za svaki poziv: vraceni rezultat ne smije dijeliti memoriju sa sljedecim
+	outputImage.release();
+	integralImage.filterBox(convolutionKernel.rows, convolutionKernel.cols, coefficient, outputImage, parallel);
+	return outputImage;
+}
+
+Mat Convolution_Box::performConvolution()
+{
+	return convolve(false);
+}
+
+Mat Convolution_Box::performParallelConvolution()
+{
+	return convolve(true);
+}
+
+String Convolution_Box::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nBox filter (" + kernelDescription + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nBox filter (" + kernelDescription + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+
+	if (constantKernel) {
+		Mat output = performParallelConvolution().clone();
+		directConvolution(true);
+		log += " Najvece odstupanje od direktne: " + to_string((int)norm(output, outputImage, NORM_INF)) + " nivoa";
+	}
+
+	// Jedna integralna slika za sve velicine prozora: mjeri se njeno racunanje, pa svaki prozor posebno
+	int largestSize = *max_element(testSizes.begin(), testSizes.end());
+	log += "\nIntegralna slika (prosirenje " + to_string(largestSize / 2) + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([&]() { prepareIntegralImage(largestSize / 2, false); return outputImage; });
+	log += "\nIntegralna slika (prosirenje " + to_string(largestSize / 2) + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([&]() { prepareIntegralImage(largestSize / 2, true); return outputImage; });
+	for (int size : testSizes) {
+		double weight = 1.0 / ((double)size * size);
+		log += "\nSrednja vrijednost " + to_string(size) + " x " + to_string(size) + " iz iste integralne slike, paralelno izvrsavanje: ";
+		log += measureExecutionTime([&]() { return filterBox(size, weight, true); });
+	}
+	return log;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+#include "IntegralImage.h"
+
+using namespace cv;
+using namespace std;
+
+// Kernel ciji su svi koeficijenti jednaki (box blur, srednja vrijednost) racuna se iz integralne slike:
+// izlaz je zbir prozora (cetiri citanja) puta koeficijent, pa cijena po pikselu ne zavisi od velicine
+// kernela. Integralna slika vazi dok se ne promijeni ulazna slika, pa ni ponovljena konvolucija ni
+// filterBox() za vise velicina prozora iste slike ne racunaju je ponovo ako je prosirena bar za pola
+// najveceg prozora; test() tako mjeri i velicine zadate sa --box-sizes=3,9,27,81. Ostali kerneli se
+// racunaju direktno u double.
+// Ivice prema --border=zero|replicate|reflect101|wrap.
+class Convolution_Box
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    BorderMode borderMode;
+    bool constantKernel;
+    double coefficient;
+    vector<int> testSizes;
+    String kernelDescription;
+    IntegralImage integralImage;
+    bool integralImageReady;
+    Mat outputImage;
+
+    void directConvolution(bool parallel);
+    Mat convolve(bool parallel);
+
+public:
+    Convolution_Box(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Racuna integralnu sliku trenutne ulazne slike prosirenu za padding piksela (i kada vec postoji)
+    void prepareIntegralImage(int padding, bool parallel);
+    // Prozor size x size sa tezinom weight iz postojece integralne slike (racuna je ako ne postoji ili je premalo prosirena)
+    Mat filterBox(int size, double weight, bool parallel);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
@@ -0,0 +1,211 @@
+#include "Convolution_FFT.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+// Koliko je FFT operacija skuplja od jednog mnozenja-sabiranja direktne petlje
+// (losiji pristup memoriji, kopiranje blokova, kompleksna aritmetika)
+static const double fftOverheadFactor = 2.0;
+
+Convolution_FFT::Convolution_FFT(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_FFT::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	fftMode = arguments.getOption("fft", "auto");
+	if (fftMode != "auto" && fftMode != "on" && fftMode != "off") {
+		throw invalid_argument("Opcija --fft mora biti auto, on ili off");
+	}
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	dftSize = 0;
+}
+
+void Convolution_FFT::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_FFT::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_FFT::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+bool Convolution_FFT::chooseFFT(int rows, int cols)
+{
+	int kernelSize = convolutionKernel.rows;
+
+	// Direktna konvolucija: K^2 mnozenja-sabiranja (2 operacije) po pikselu i kanalu
+	double directCost = 2.0 * kernelSize * kernelSize * (double)rows * cols * 3;
+
+	// Za svaku kandidatsku velicinu transformacije procjenjuje se ukupna cijena svih blokova:
+	// dvije realne transformacije (~2.5 N^2 log2(N^2) operacija) i kompleksno mnozenje (6 N^2)
+	double bestFFTCost = 0;
+	int bestSize = 0;
+	int candidates[] = { 32, 64, 128, 256, 512, 1024 };
+	for (int candidate : candidates) {
+		int size = getOptimalDFTSize(max(candidate, 2 * kernelSize));
+		int blockSize = size - kernelSize + 1;
+
+		// Transformacija veca od slike samo trosi vrijeme
+		if (blockSize > max(rows, cols) && bestSize != 0) {
+			break;
+		}
+
+		double tiles = ceil((double)rows / blockSize) * ceil((double)cols / blockSize);
+		double area = (double)size * size;
+		double cost = tiles * 3 * (2 * 2.5 * area * log2(area) + 6 * area) * fftOverheadFactor;
+		if (bestSize == 0 || cost < bestFFTCost) {
+			bestFFTCost = cost;
+			bestSize = size;
+		}
+	}
+
+	if (bestSize != dftSize) {
+		dftSize = bestSize;
+		prepareKernelSpectrum();
+	}
+
+	if (fftMode == "on") {
+		return true;
+	}
+	if (fftMode == "off") {
+		return false;
+	}
+	return bestFFTCost < directCost;
+}
+
+void Convolution_FFT::prepareKernelSpectrum()
+{
+	// Kernel u gornjem lijevom uglu N x N matrice; mnozenjem konjugovanim spektrom dobija se
+	// korelacija, isto kao u direktnim petljama (kernel se ne okrece)
+	Mat paddedKernel(dftSize, dftSize, CV_64F, Scalar(0));
+	convolutionKernel.copyTo(paddedKernel(Rect(0, 0, convolutionKernel.cols, convolutionKernel.rows)));
+	dft(paddedKernel, kernelSpectrum, DFT_COMPLEX_OUTPUT);
+}
+
+void Convolution_FFT::fftConvolution(Mat& resultImage, bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int kernelSize = convolutionKernel.rows;
+	int half = kernelSize / 2;
+	int blockSize = dftSize - kernelSize + 1;
+	int tilesX = (rows + blockSize - 1) / blockSize;
+	int tilesY = (cols + blockSize - 1) / blockSize;
+
+	resultImage = Mat(rows, cols, CV_64FC3);
+
+	forEachIndex(tilesX * tilesY, parallel, [&](int tile) {
+		int tileX = (tile / tilesY) * blockSize;
+		int tileY = (tile % tilesY) * blockSize;
+		int outputRows = min(blockSize, rows - tileX);
+		int outputCols = min(blockSize, cols - tileY);
+
+		Mat region(dftSize, dftSize, CV_64F);
+		Mat spectrum, product, block;
+
+		// Redovi i kolone ulaznog bloka sa okvirom preslikani u sliku prema nacinu prosirenja
+		vector<int> sourceRows(outputRows + kernelSize - 1);
+		vector<int> sourceCols(outputCols + kernelSize - 1);
+		for (int i = 0; i < (int)sourceRows.size(); i++) {
+			sourceRows[i] = mapBorderIndex(tileX - half + i, rows, borderMode);
+		}
+		for (int j = 0; j < (int)sourceCols.size(); j++) {
+			sourceCols[j] = mapBorderIndex(tileY - half + j, cols, borderMode);
+		}
+
+		for (int c = 0; c < 3; c++) {
+			// Ulazni blok sa okvirom; pikseli koje prosirenje ne popunjava (-1) ostaju nule
+			region.setTo(Scalar(0));
+			for (int i = 0; i < (int)sourceRows.size(); i++) {
+				if (sourceRows[i] < 0) {
+					continue;
+				}
+				const double* source = inputImage.ptr<double>(sourceRows[i]);
+				double* destination = region.ptr<double>(i);
+				for (int j = 0; j < (int)sourceCols.size(); j++) {
+					if (sourceCols[j] >= 0) {
+						destination[j] = source[3 * sourceCols[j] + c];
+					}
+				}
+			}
+
+			dft(region, spectrum, DFT_COMPLEX_OUTPUT, outputRows + kernelSize - 1);
+			mulSpectrums(spectrum, kernelSpectrum, product, 0, true);
+			dft(product, block, DFT_INVERSE | DFT_SCALE | DFT_REAL_OUTPUT, outputRows);
+
+			// Samo prvih B x B vrijednosti nije pogodjeno kruznim preklapanjem
+			for (int i = 0; i < outputRows; i++) {
+				const double* source = block.ptr<double>(i);
+				double* destination = resultImage.ptr<double>(tileX + i);
+				for (int j = 0; j < outputCols; j++) {
+					destination[3 * (tileY + j) + c] = source[j];
+				}
+			}
+		}
+	});
+}
+
+Mat Convolution_FFT::performConvolution()
+{
+	inputImage.convertTo(inputImage, CV_64FC3);
+
+	Mat resultImage;
+	if (chooseFFT(inputImage.rows, inputImage.cols)) {
+		fftConvolution(resultImage, false);
+	}
+	else {
+		convolveDirect(inputImage, convolutionKernel, borderMode, resultImage, false);
+	}
+	Mat outputImage = outputBuffer;
+	resultImage.convertTo(outputImage, CV_8UC3);
+	return outputImage;
+}
+
+Mat Convolution_FFT::performParallelConvolution()
+{
+	inputImage.convertTo(inputImage, CV_64FC3);
+
+	Mat resultImage;
+	if (chooseFFT(inputImage.rows, inputImage.cols)) {
+		fftConvolution(resultImage, true);
+	}
+	else {
+		convolveDirect(inputImage, convolutionKernel, borderMode, resultImage, true);
+	}
+	Mat outputImage = outputBuffer;
+	resultImage.convertTo(outputImage, CV_8UC3);
+	return outputImage;
+}
+
+String Convolution_FFT::test()
+{
+	bool useFFT = chooseFFT(inputImage.rows, inputImage.cols);
+	String method = useFFT ? "FFT, blok " + to_string(dftSize) + " x " + to_string(dftSize) : "direktno";
+	method += ", ivice: " + getBorderModeName(borderMode);
+
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nFFT konvolucija (" + method + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nFFT konvolucija (" + method + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	return log;
+}
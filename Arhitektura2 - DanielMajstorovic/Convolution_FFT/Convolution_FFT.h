@@ -0,0 +1,49 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija preko FFT-a u blokovima (overlap-save): izlaz se dijeli na blokove B x B, svaki blok
+// ucitava ulaz sa okvirom od K - 1 piksela u N x N transformaciju (N = B + K - 1 zaokruzeno na
+// optimalnu DFT velicinu), mnozi se spektrom kernela i vraca inverznom transformacijom.
+// Cijela slika nikad nije u jednoj transformaciji.
+//
+// Model cijene bira direktnu ili FFT konvoluciju za datu velicinu slike i kernela
+// (--fft=auto, podrazumijevano), a moze se i prisiliti sa --fft=on ili --fft=off.
+//
+// Tacnost: racuna se u double preciznosti, pa je razlika prema direktnoj konvoluciji prije
+// konverzije u 8 bita manja od 1e-9 * 255 * sum(|k|), a nakon konverzije najvise 1 nivo
+// (samo kada je tacna vrijednost na samoj granici zaokruzivanja). To vazi za svaki nacin prosirenja
+// (--border=zero|replicate|reflect101|wrap): okvir bloka i direktna petlja citaju piksele van slike
+// preko mapBorderIndex, isto kao direktne varijante.
+class Convolution_FFT
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    Mat outputBuffer;
+    String fftMode;
+    BorderMode borderMode;
+    int dftSize;
+    Mat kernelSpectrum;
+
+    bool chooseFFT(int rows, int cols);
+    void prepareKernelSpectrum();
+    void fftConvolution(Mat& resultImage, bool parallel);
+
+public:
+    Convolution_FFT(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
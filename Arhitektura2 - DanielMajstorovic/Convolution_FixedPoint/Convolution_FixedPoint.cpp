@@ -0,0 +1,260 @@
+#include "Convolution_FixedPoint.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+#include <climits>
+#include <cstring>
+#include <immintrin.h>
+
+// Dodatni pikseli desno da posljednje 32-bajtno ucitavanje reda ne izadje iz slike
+static const int extraRightPadding = 11;
+
+Convolution_FixedPoint::Convolution_FixedPoint(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_FixedPoint::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	String mode = arguments.getOption("fixed", "auto");
+
+	vector<FixedPointTap> narrowTaps, wideTaps;
+	int narrowShift = 0, wideShift = 0;
+	double narrowError = 0, wideError = 0;
+	bool narrowPossible = quantizeKernel(127, SHRT_MAX, 7, narrowTaps, narrowShift, narrowError);
+	bool widePossible = quantizeKernel(SHRT_MAX, INT_MAX, 15, wideTaps, wideShift, wideError);
+
+	// 16-bitni put ako je dozvoljen i ne gubi preciznost (ili greska ostaje ispod pola nivoa)
+	if (mode == "16") {
+		narrowAccumulators = true;
+	}
+	else if (mode == "32") {
+		narrowAccumulators = false;
+	}
+	else if (mode == "auto") {
+		narrowAccumulators = narrowPossible && (!widePossible || narrowError <= wideError || narrowError <= 0.5);
+	}
+	else {
+		throw invalid_argument("Opcija --fixed mora biti auto, 16 ili 32");
+	}
+
+	if (narrowAccumulators && !narrowPossible) {
+		throw invalid_argument("Kernel se ne moze predstaviti sa 16-bitnim akumulatorima");
+	}
+	if (!narrowAccumulators && !widePossible) {
+		throw invalid_argument("Kernel se ne moze predstaviti u fiksnom zarezu");
+	}
+
+	taps = narrowAccumulators ? narrowTaps : wideTaps;
+	shift = narrowAccumulators ? narrowShift : wideShift;
+	maxOutputError = narrowAccumulators ? narrowError : wideError;
+
+	maxCoefficientError = 0;
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			double value = convolutionKernel.at<double>(u, v);
+			double quantized = round(value * (1 << shift)) / (1 << shift);
+			maxCoefficientError = max(maxCoefficientError, fabs(value - quantized));
+		}
+	}
+
+	// Tapovi se obradjuju u parovima, pa se neparan broj dopunjava tapom sa koeficijentom 0
+	if (taps.size() % 2 != 0) {
+		FixedPointTap empty = { 0, 0, 0 };
+		taps.push_back(empty);
+	}
+}
+
+bool Convolution_FixedPoint::quantizeKernel(int maxCoefficient, int maxAccumulator, int maxShift, vector<FixedPointTap>& quantizedTaps, int& quantizedShift, double& outputError)
+{
+	// Najveci pomak (najveca preciznost) za koji koeficijenti i akumulator ne prelaze opseg
+	for (int s = maxShift; s >= 0; s--) {
+		double scale = (double)(1 << s);
+		double absoluteSum = 0;
+		double errorSum = 0;
+		bool fits = true;
+		vector<FixedPointTap> candidate;
+
+		for (int u = 0; u < convolutionKernel.rows && fits; u++) {
+			for (int v = 0; v < convolutionKernel.cols; v++) {
+				double value = convolutionKernel.at<double>(u, v);
+				double quantized = round(value * scale);
+				if (fabs(quantized) > maxCoefficient) {
+					fits = false;
+					break;
+				}
+				absoluteSum += fabs(quantized);
+				errorSum += fabs(value - quantized / scale);
+				if (quantized != 0) {
+					FixedPointTap tap = { u, 3 * v, (int)quantized };
+					candidate.push_back(tap);
+				}
+			}
+		}
+
+		double rounding = s > 0 ? (double)(1 << (s - 1)) : 0;
+		if (fits && 255.0 * absoluteSum + rounding <= maxAccumulator) {
+			quantizedTaps = candidate;
+			quantizedShift = s;
+			outputError = 255.0 * errorSum;
+			return true;
+		}
+	}
+	return false;
+}
+
+void Convolution_FixedPoint::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_FixedPoint::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_FixedPoint::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+void Convolution_FixedPoint::convolveRowNarrow(const Mat& paddedImage, int x, uchar* destination)
+{
+	int samples = 3 * inputImage.cols;
+	__m256i rounding = _mm256_set1_epi16(shift > 0 ? (short)(1 << (shift - 1)) : 0);
+	__m128i shiftCount = _mm_cvtsi32_si128(shift);
+
+	// Kanali su isprepleteni (BGR), pa se red posmatra kao niz uzoraka i vektorizuje preko 32 uzorka
+	for (int j = 0; j < samples; j += 32) {
+		__m256i low = _mm256_setzero_si256();
+		__m256i high = _mm256_setzero_si256();
+
+		for (size_t t = 0; t < taps.size(); t += 2) {
+			const uchar* first = paddedImage.ptr<uchar>(x + taps[t].row) + taps[t].byteOffset + j;
+			const uchar* second = paddedImage.ptr<uchar>(x + taps[t + 1].row) + taps[t + 1].byteOffset + j;
+			__m256i firstSamples = _mm256_loadu_si256((const __m256i*)first);
+			__m256i secondSamples = _mm256_loadu_si256((const __m256i*)second);
+
+			// Par koeficijenata (int8) za maddubs: a[2i] * w0 + a[2i+1] * w1
+			__m256i weights = _mm256_set1_epi16((short)((taps[t + 1].coefficient << 8) | (taps[t].coefficient & 0xff)));
+			low = _mm256_add_epi16(low, _mm256_maddubs_epi16(_mm256_unpacklo_epi8(firstSamples, secondSamples), weights));
+			high = _mm256_add_epi16(high, _mm256_maddubs_epi16(_mm256_unpackhi_epi8(firstSamples, secondSamples), weights));
+		}
+
+		low = _mm256_sra_epi16(_mm256_add_epi16(low, rounding), shiftCount);
+		high = _mm256_sra_epi16(_mm256_add_epi16(high, rounding), shiftCount);
+
+		// packus u okviru 128-bitnih polovina ponistava raspored iz unpacklo/unpackhi
+		__m256i result = _mm256_packus_epi16(low, high);
+		if (j + 32 <= samples) {
+			_mm256_storeu_si256((__m256i*)(destination + j), result);
+		}
+		else {
+			alignas(32) uchar tail[32];
+			_mm256_store_si256((__m256i*)tail, result);
+			memcpy(destination + j, tail, samples - j);
+		}
+	}
+}
+
+void Convolution_FixedPoint::convolveRowWide(const Mat& paddedImage, int x, uchar* destination)
+{
+	int samples = 3 * inputImage.cols;
+	__m256i rounding = _mm256_set1_epi32(shift > 0 ? 1 << (shift - 1) : 0);
+	__m128i shiftCount = _mm_cvtsi32_si128(shift);
+
+	for (int j = 0; j < samples; j += 16) {
+		__m256i low = _mm256_setzero_si256();
+		__m256i high = _mm256_setzero_si256();
+
+		for (size_t t = 0; t < taps.size(); t += 2) {
+			const uchar* first = paddedImage.ptr<uchar>(x + taps[t].row) + taps[t].byteOffset + j;
+			const uchar* second = paddedImage.ptr<uchar>(x + taps[t + 1].row) + taps[t + 1].byteOffset + j;
+			__m256i firstSamples = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)first));
+			__m256i secondSamples = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)second));
+
+			// Par koeficijenata (int16) za madd: a[2i] * w0 + a[2i+1] * w1 u 32 bita
+			__m256i weights = _mm256_set1_epi32((taps[t + 1].coefficient << 16) | (taps[t].coefficient & 0xffff));
+			low = _mm256_add_epi32(low, _mm256_madd_epi16(_mm256_unpacklo_epi16(firstSamples, secondSamples), weights));
+			high = _mm256_add_epi32(high, _mm256_madd_epi16(_mm256_unpackhi_epi16(firstSamples, secondSamples), weights));
+		}
+
+		low = _mm256_sra_epi32(_mm256_add_epi32(low, rounding), shiftCount);
+		high = _mm256_sra_epi32(_mm256_add_epi32(high, rounding), shiftCount);
+
+		// 32 -> 16 -> 8 bita sa saturacijom; permutacija spaja donje polovine oba 128-bitna dijela
+		__m256i words = _mm256_packs_epi32(low, high);
+		__m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+		__m128i result = _mm256_castsi256_si128(bytes);
+		if (j + 16 <= samples) {
+			_mm_storeu_si128((__m128i*)(destination + j), result);
+		}
+		else {
+			alignas(16) uchar tail[16];
+			_mm_store_si128((__m128i*)tail, result);
+			memcpy(destination + j, tail, samples - j);
+		}
+	}
+}
+
+Mat Convolution_FixedPoint::convolve(bool parallel)
+{
+	int half = convolutionKernel.rows / 2;
+
+	// Prosirenje u 8 bita (1 bajt po uzorku umjesto 8 za double)
+	Mat paddedImage;
+	padImage(inputImage, paddedImage, half, half, half, half + extraRightPadding, borderMode);
+
+	Mat resultImage = outputBuffer;
+	resultImage.create(inputImage.rows, inputImage.cols, CV_8UC3);
+	forEachIndex(inputImage.rows, parallel, [&](int x) {
+		if (narrowAccumulators) {
+			convolveRowNarrow(paddedImage, x, resultImage.ptr<uchar>(x));
+		}
+		else {
+			convolveRowWide(paddedImage, x, resultImage.ptr<uchar>(x));
+		}
+	});
+	return resultImage;
+}
+
+Mat Convolution_FixedPoint::performConvolution()
+{
+	return convolve(false);
+}
+
+Mat Convolution_FixedPoint::performParallelConvolution()
+{
+	return convolve(true);
+}
+
+String Convolution_FixedPoint::getQuantizationReport()
+{
+	String report = narrowAccumulators ? "16-bitni akumulatori" : "32-bitni akumulatori";
+	report += ", skala 2^" + to_string(shift);
+	report += ", max greska koeficijenta " + to_string(maxCoefficientError);
+	report += ", max greska piksela " + to_string(maxOutputError);
+	return report;
+}
+
+String Convolution_FixedPoint::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nFiksni zarez (" + getQuantizationReport() + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nFiksni zarez (" + getQuantizationReport() + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	return log;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Jedan tap kernela u fiksnom zarezu: pomak reda u kernelu, pomak u bajtovima unutar reda
+// (3 * kolona, jer su pikseli BGR) i kvantizovani koeficijent
+struct FixedPointTap
+{
+    int row;
+    int byteOffset;
+    int coefficient;
+};
+
+// Konvolucija direktno nad CV_8UC3 podacima u fiksnom zarezu. Kernel se kvantizuje na
+// q = round(k * 2^shift) i racuna se sa AVX2 cjelobrojnim mnozenjem-sabiranjem:
+//  - 16-bitni akumulatori (_mm256_maddubs_epi16, 32 uzorka po instrukciji) kada su svi
+//    koeficijenti u int8 i 255 * sum(|q|) staje u int16,
+//  - 32-bitni akumulatori (_mm256_madd_epi16, 16 uzoraka po instrukciji) u ostalim slucajevima.
+// Rezultat se zaokruzuje pomjeranjem za shift i saturira direktno u 8 bita.
+// Opcija --fixed=auto|16|32 bira put; greska kvantizacije prijavljuje se u test().
+// Slika se prosiruje prema --border=zero|replicate|reflect101|wrap u 8-bitnu kopiju (padImage): za
+// razliku od ostalih varijanti, 32-bajtna ucitavanja citaju i piksele van slike, pa ih kopija mora imati.
+class Convolution_FixedPoint
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    Mat outputBuffer;
+    vector<FixedPointTap> taps;
+    int shift;
+    bool narrowAccumulators;
+    BorderMode borderMode;
+    double maxCoefficientError;
+    double maxOutputError;
+
+    bool quantizeKernel(int maxCoefficient, int maxAccumulator, int maxShift, vector<FixedPointTap>& quantizedTaps, int& quantizedShift, double& outputError);
+    void convolveRowNarrow(const Mat& paddedImage, int x, uchar* destination);
+    void convolveRowWide(const Mat& paddedImage, int x, uchar* destination);
+    Mat convolve(bool parallel);
+
+public:
+    Convolution_FixedPoint(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String getQuantizationReport();
+    String test();
+};
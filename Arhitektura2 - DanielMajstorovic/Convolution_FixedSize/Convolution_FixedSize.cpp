@@ -0,0 +1,230 @@
+#include "Convolution_FixedSize.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <type_traits>
+
+// Odmotavanje u vrijeme prevodjenja: body se poziva sa integral_constant<int, 0> ... <N - 1>
+template <int N>
+struct Unroll
+{
+	template <class Body>
+	static inline void run(Body& body)
+	{
+		Unroll<N - 1>::run(body);
+		body(integral_constant<int, N - 1>());
+	}
+};
+
+template <>
+struct Unroll<0>
+{
+	template <class Body>
+	static inline void run(Body&)
+	{
+	}
+};
+
+template <int K>
+static void convolveRowFixed(const uchar* const* rows, const double* taps, int, int firstCol, int lastCol, uchar* destination)
+{
+	double coefficients[K * K];
+	for (int i = 0; i < K * K; i++) {
+		coefficients[i] = taps[i];
+	}
+
+	for (int y = firstCol; y < lastCol; y++) {
+		double b = 0, g = 0, r = 0;
+		// Isti redoslijed sabiranja (u spolja, v unutra) kao u performConvolution postojecih varijanti
+		auto kernelRow = [&](auto u) {
+			const uchar* source = rows[decltype(u)::value] + 3 * (y - K / 2);
+			auto tap = [&](auto v) {
+				const double coefficient = coefficients[decltype(u)::value * K + decltype(v)::value];
+				b += source[3 * decltype(v)::value] * coefficient;
+				g += source[3 * decltype(v)::value + 1] * coefficient;
+				r += source[3 * decltype(v)::value + 2] * coefficient;
+			};
+			Unroll<K>::run(tap);
+		};
+		Unroll<K>::run(kernelRow);
+
+		destination[3 * y] = saturate_cast<uchar>(b);
+		destination[3 * y + 1] = saturate_cast<uchar>(g);
+		destination[3 * y + 2] = saturate_cast<uchar>(r);
+	}
+}
+
+static void convolveRowGeneric(const uchar* const* rows, const double* taps, int kernelSize, int firstCol, int lastCol, uchar* destination)
+{
+	for (int y = firstCol; y < lastCol; y++) {
+		double b = 0, g = 0, r = 0;
+		for (int u = 0; u < kernelSize; u++) {
+			const uchar* source = rows[u] + 3 * (y - kernelSize / 2);
+			const double* coefficients = taps + u * kernelSize;
+			for (int v = 0; v < kernelSize; v++) {
+				b += source[3 * v] * coefficients[v];
+				g += source[3 * v + 1] * coefficients[v];
+				r += source[3 * v + 2] * coefficients[v];
+			}
+		}
+
+		destination[3 * y] = saturate_cast<uchar>(b);
+		destination[3 * y + 1] = saturate_cast<uchar>(g);
+		destination[3 * y + 2] = saturate_cast<uchar>(r);
+	}
+}
+
+// Kolone uz ivicu: indeksi izvora za svaki tap su u colIndices (-1 za nulu), istim redoslijedom sabiranja
+static void convolveBorderColumn(const uchar* const* rows, const double* taps, int kernelSize, const int* colIndices, int y, uchar* destination)
+{
+	double b = 0, g = 0, r = 0;
+	for (int u = 0; u < kernelSize; u++) {
+		const double* coefficients = taps + u * kernelSize;
+		for (int v = 0; v < kernelSize; v++) {
+			if (colIndices[v] < 0) {
+				continue;
+			}
+			const uchar* source = rows[u] + 3 * colIndices[v];
+			b += source[0] * coefficients[v];
+			g += source[1] * coefficients[v];
+			r += source[2] * coefficients[v];
+		}
+	}
+	destination[3 * y] = saturate_cast<uchar>(b);
+	destination[3 * y + 1] = saturate_cast<uchar>(g);
+	destination[3 * y + 2] = saturate_cast<uchar>(r);
+}
+
+Convolution_FixedSize::Convolution_FixedSize(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_FixedSize::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	String mode = arguments.getOption("specialize", "auto");
+	if (mode != "auto" && mode != "off") {
+		throw invalid_argument("Opcija --specialize mora biti auto ili off");
+	}
+
+	kernelTaps.resize(convolutionKernel.rows * convolutionKernel.cols);
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			kernelTaps[u * convolutionKernel.cols + v] = convolutionKernel.at<double>(u, v);
+		}
+	}
+
+	// Izbor specijalizacije jednom, pri ucitavanju kernela
+	specialized = mode == "auto";
+	switch (specialized ? convolutionKernel.rows : 0) {
+	case 3:
+		rowFunction = convolveRowFixed<3>;
+		break;
+	case 5:
+		rowFunction = convolveRowFixed<5>;
+		break;
+	case 7:
+		rowFunction = convolveRowFixed<7>;
+		break;
+	default:
+		rowFunction = convolveRowGeneric;
+		specialized = false;
+		break;
+	}
+}
+
+void Convolution_FixedSize::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_FixedSize::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_FixedSize::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+Mat Convolution_FixedSize::convolve(bool parallel)
+{
+	int kernelSize = convolutionKernel.rows;
+	int half = kernelSize / 2;
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+
+	// Bez prosirene kopije: redovi kernela su pokazivaci na redove ulaza preslikane prema nacinu
+	// prosirenja (nulti red za piksele van slike), a kolone van slike postoje samo u kolonama uz
+	// ivicu, za koje se indeksi izvora preslikaju jednom u tabelu
+	Rect interior = interiorRegion(inputImage.size(), convolutionKernel.size());
+	vector<uchar> zeroRow(3 * (size_t)cols, 0);
+	vector<int> borderCols;
+	for (int y = 0; y < cols; y++) {
+		if (y < interior.x || y >= interior.x + interior.width) {
+			borderCols.push_back(y);
+		}
+	}
+	vector<int> colTable(borderCols.size() * kernelSize);
+	for (size_t i = 0; i < borderCols.size(); i++) {
+		for (int v = 0; v < kernelSize; v++) {
+			colTable[i * kernelSize + v] = mapBorderIndex(borderCols[i] - half + v, cols, borderMode);
+		}
+	}
+
+	Mat resultImage = outputBuffer;
+	resultImage.create(rows, cols, CV_8UC3);
+	forEachIndex(rows, parallel, [&](int x) {
+		vector<const uchar*> sourceRows(kernelSize);
+		for (int u = 0; u < kernelSize; u++) {
+			int sourceRow = mapBorderIndex(x - half + u, rows, borderMode);
+			sourceRows[u] = sourceRow < 0 ? zeroRow.data() : inputImage.ptr<uchar>(sourceRow);
+		}
+		uchar* destination = resultImage.ptr<uchar>(x);
+		rowFunction(sourceRows.data(), kernelTaps.data(), kernelSize, interior.x, interior.x + interior.width, destination);
+		for (size_t i = 0; i < borderCols.size(); i++) {
+			convolveBorderColumn(sourceRows.data(), kernelTaps.data(), kernelSize, &colTable[i * kernelSize], borderCols[i], destination);
+		}
+	});
+	return resultImage;
+}
+
+Mat Convolution_FixedSize::performConvolution()
+{
+	return convolve(false);
+}
+
+Mat Convolution_FixedSize::performParallelConvolution()
+{
+	return convolve(true);
+}
+
+String Convolution_FixedSize::getSpecialization()
+{
+	if (specialized) {
+		return to_string(convolutionKernel.rows) + "x" + to_string(convolutionKernel.cols) + " specijalizacija";
+	}
+	return "genericka petlja";
+}
+
+String Convolution_FixedSize::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nFiksna velicina kernela (" + getSpecialization() + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nFiksna velicina kernela (" + getSpecialization() + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	return log;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija sa velicinom kernela poznatom u vrijeme prevodjenja. Za 3x3, 5x5 i 7x7 koristi se
+// sablon instanciran za K, u kome su petlje po tapovima potpuno odmotane a koeficijenti kopirani u
+// lokalni niz fiksne velicine, pa ih prevodilac drzi u registrima (ili na steku za 7x7) umjesto da
+// za svaki tap i piksel poziva convolutionKernel.at<double>(). Ostale velicine idu kroz genericku
+// petlju sa istim redoslijedom sabiranja. Opcija --specialize=off uvijek bira genericku petlju.
+// Ivice prema --border=zero|replicate|reflect101|wrap, bez prosirene kopije: redovi i kolone van slike
+// preslikavaju se mapBorderIndex.
+class Convolution_FixedSize
+{
+    // Izlazne kolone [firstCol, lastCol) jednog reda; rows[u] je red ulaza za red u kernela
+    typedef void (*RowFunction)(const uchar* const* rows, const double* taps, int kernelSize, int firstCol, int lastCol, uchar* destination);
+
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    Mat outputBuffer;
+    vector<double> kernelTaps;
+    RowFunction rowFunction;
+    bool specialized;
+    BorderMode borderMode;
+
+    Mat convolve(bool parallel);
+
+public:
+    Convolution_FixedSize(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String getSpecialization();
+    String test();
+};
@@ -0,0 +1,244 @@
+#include "Convolution_Fused.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+Convolution_Fused::Convolution_Fused(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Fused::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	setStages(arguments.getKernels());
+}
+
+void Convolution_Fused::setStages(const vector<Mat>& kernels)
+{
+	if (kernels.empty()) {
+		throw invalid_argument("Potrebna je bar jedna faza");
+	}
+	stageKernels = kernels;
+	convolutionKernel = kernels[0];
+
+	stageTaps.resize(kernels.size());
+	for (size_t s = 0; s < kernels.size(); s++) {
+		stageTaps[s].resize(kernels[s].rows * kernels[s].cols);
+		for (int u = 0; u < kernels[s].rows; u++) {
+			for (int v = 0; v < kernels[s].cols; v++) {
+				stageTaps[s][u * kernels[s].cols + v] = (float)kernels[s].at<double>(u, v);
+			}
+		}
+	}
+}
+
+void Convolution_Fused::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Fused::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_Fused::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+void Convolution_Fused::convolveStage(int stage, const float* source, float* destination, int planeSize, int stride, int rows, int cols)
+{
+	int kernelSize = stageKernels[stage].rows;
+	const float* taps = stageTaps[stage].data();
+
+	// Unutrasnja petlja ide uzastopno kroz red jednog kanala, pa je kompajler vektorizuje
+	for (int c = 0; c < 3; c++) {
+		for (int i = 0; i < rows; i++) {
+			float* output = destination + c * planeSize + i * stride;
+			for (int j = 0; j < cols; j++) {
+				output[j] = 0;
+			}
+			for (int u = 0; u < kernelSize; u++) {
+				const float* input = source + c * planeSize + (i + u) * stride;
+				for (int v = 0; v < kernelSize; v++) {
+					float weight = taps[u * kernelSize + v];
+					const float* shifted = input + v;
+					for (int j = 0; j < cols; j++) {
+						output[j] += weight * shifted[j];
+					}
+				}
+			}
+		}
+	}
+}
+
+Mat Convolution_Fused::convolve(const Mat& image, int firstStage, int lastStage, bool parallel)
+{
+	int halo = 0;
+	for (int s = firstStage; s < lastStage; s++) {
+		halo += stageKernels[s].rows / 2;
+	}
+
+	// Dva float bafera po pikselu i kanalu; blok se bira kao za jedan kernel velicine cijelog lanca
+	TileShape tile = chooseTileShape(2 * halo + 1, 2 * halo + 1, 2 * 3 * sizeof(float));
+	int stride = tile.cols + 2 * halo;
+	int planeSize = (tile.rows + 2 * halo) * stride;
+
+	// Samo posljednja faza upisuje u zadati izlazni bafer; medjurezultati faza su uvijek novi
+	Mat resultImage = lastStage == (int)stageKernels.size() ? outputBuffer : Mat();
+	resultImage.create(image.rows, image.cols, CV_8UC3);
+	forEachTile(Rect(0, 0, image.cols, image.rows), tile, parallel, [&](Rect block) {
+		// Baferi se zadrzavaju izmedju blokova iste niti
+		static thread_local vector<float> first, second;
+		first.resize(3 * planeSize);
+		second.resize(3 * planeSize);
+		float* source = first.data();
+		float* destination = second.data();
+
+		// Ucitavanje bloka sa rubom u planarni float oblik, van slike prema nacinu prosirenja
+		int margin = halo;
+		int rows = block.height + 2 * margin;
+		int cols = block.width + 2 * margin;
+		for (int i = 0; i < rows; i++) {
+			int x = mapBorderIndex(block.y - margin + i, image.rows, borderMode);
+			for (int j = 0; j < cols; j++) {
+				int y = mapBorderIndex(block.x - margin + j, image.cols, borderMode);
+				bool inside = x >= 0 && y >= 0;
+				const uchar* pixel = inside ? image.ptr<uchar>(x) + 3 * y : nullptr;
+				for (int c = 0; c < 3; c++) {
+					source[c * planeSize + i * stride + j] = inside ? pixel[c] : 0.0f;
+				}
+			}
+		}
+
+		for (int s = firstStage; s < lastStage; s++) {
+			int half = stageKernels[s].rows / 2;
+			margin -= half;
+			rows -= 2 * half;
+			cols -= 2 * half;
+			convolveStage(s, source, destination, planeSize, stride, rows, cols);
+
+			if (s == lastStage - 1) {
+				break;
+			}
+
+			// Medjurezultat kao da je upisan u CV_8UC3 sliku: zaokruzivanje i 0-255 u slici, pa van slike
+			// nula ili vrijednost preslikanog piksela (za replicate i reflect101 je unutar bloka)
+			for (int i = 0; i < rows; i++) {
+				int x = block.y - margin + i;
+				for (int j = 0; j < cols; j++) {
+					int y = block.x - margin + j;
+					if (x >= 0 && x < image.rows && y >= 0 && y < image.cols) {
+						for (int c = 0; c < 3; c++) {
+							float& value = destination[c * planeSize + i * stride + j];
+							value = min(max(nearbyintf(value), 0.0f), 255.0f);
+						}
+					}
+				}
+			}
+			for (int i = 0; i < rows; i++) {
+				int x = block.y - margin + i;
+				int sourceRow = mapBorderIndex(x, image.rows, borderMode);
+				for (int j = 0; j < cols; j++) {
+					int y = block.x - margin + j;
+					if (x >= 0 && x < image.rows && y >= 0 && y < image.cols) {
+						continue;
+					}
+					int sourceCol = mapBorderIndex(y, image.cols, borderMode);
+					bool mapped = sourceRow >= 0 && sourceCol >= 0;
+					int offset = (sourceRow - (block.y - margin)) * stride + sourceCol - (block.x - margin);
+					for (int c = 0; c < 3; c++) {
+						destination[c * planeSize + i * stride + j] = mapped ? destination[c * planeSize + offset] : 0.0f;
+					}
+				}
+			}
+			swap(source, destination);
+		}
+
+		for (int i = 0; i < block.height; i++) {
+			uchar* output = resultImage.ptr<uchar>(block.y + i) + 3 * block.x;
+			for (int j = 0; j < block.width; j++) {
+				for (int c = 0; c < 3; c++) {
+					output[3 * j + c] = saturate_cast<uchar>(destination[c * planeSize + i * stride + j]);
+				}
+			}
+		}
+	});
+	return resultImage;
+}
+
+Mat Convolution_Fused::performConvolution()
+{
+	if (borderMode == BorderWrap) {
+		return performUnfusedConvolution();
+	}
+	return convolve(inputImage, 0, (int)stageKernels.size(), false);
+}
+
+Mat Convolution_Fused::performParallelConvolution()
+{
+	if (borderMode == BorderWrap) {
+		return performParallelUnfusedConvolution();
+	}
+	return convolve(inputImage, 0, (int)stageKernels.size(), true);
+}
+
+Mat Convolution_Fused::performUnfusedConvolution()
+{
+	// Svaka faza je poseban prolaz kroz cijelu sliku sa CV_8UC3 medjurezultatom
+	Mat image = inputImage;
+	for (int s = 0; s < (int)stageKernels.size(); s++) {
+		image = convolve(image, s, s + 1, false);
+	}
+	return image;
+}
+
+Mat Convolution_Fused::performParallelUnfusedConvolution()
+{
+	Mat image = inputImage;
+	for (int s = 0; s < (int)stageKernels.size(); s++) {
+		image = convolve(image, s, s + 1, true);
+	}
+	return image;
+}
+
+String Convolution_Fused::getStageReport()
+{
+	int halo = 0;
+	String report = "faze ";
+	for (size_t s = 0; s < stageKernels.size(); s++) {
+		report += (s > 0 ? " -> " : "") + to_string(stageKernels[s].rows) + "x" + to_string(stageKernels[s].cols);
+		halo += stageKernels[s].rows / 2;
+	}
+	TileShape tile = chooseTileShape(2 * halo + 1, 2 * halo + 1, 2 * 3 * sizeof(float));
+	report += ", blok " + to_string(tile.cols) + " x " + to_string(tile.rows) + ", rub " + to_string(halo);
+	if (borderMode == BorderWrap) {
+		report += ", wrap: faza po faza";
+	}
+	return report;
+}
+
+String Convolution_Fused::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nSpojene faze (" + getStageReport() + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nSpojene faze (" + getStageReport() + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	log += "\nFaza po faza, sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performUnfusedConvolution(); });
+	log += "\nFaza po faza, paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelUnfusedConvolution(); });
+	return log;
+}
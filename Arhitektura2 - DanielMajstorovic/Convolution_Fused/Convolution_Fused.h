@@ -0,0 +1,49 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "TiledExecution.h"
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Niz konvolucija (npr. zamucivanje -> izostravanje -> ivice) izvrsen spojeno po blokovima.
+// Za svaki izlazni blok ulaz se cita jednom, sa rubom jednakim zbiru polovina svih kernela.
+// Faze se racunaju redom u dva planarna float bafera (naizmjenicno ulaz i izlaz) koji staju u L2,
+// a u izlaznu sliku se upisuje samo rezultat posljednje faze.
+// Izmedju faza se vrijednosti zaokruzuju na 0-255, a van slike postavljaju prema --border (nula, ili
+// vrijednost preslikanog piksela koji za replicate i reflect101 uvijek lezi u istom bloku), kao kada
+// se faze izvrsavaju jedna za drugom nad CV_8UC3 slikama, pa je rezultat identican nespojenom
+// izvrsavanju (performUnfusedConvolution). Za wrap je preslikani piksel sa suprotne strane slike,
+// van bloka, pa se faze tada izvrsavaju jedna po jedna.
+// Faze se zadaju sa --stage izmedju kernela: ulaz izlaz k1 ... --stage k1 ... --stage ...
+class Convolution_Fused
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    Mat outputBuffer;
+    vector<Mat> stageKernels;
+    vector<vector<float>> stageTaps;
+    BorderMode borderMode;
+
+    void convolveStage(int stage, const float* source, float* destination, int planeSize, int stride, int rows, int cols);
+    Mat convolve(const Mat& image, int firstStage, int lastStage, bool parallel);
+
+public:
+    Convolution_Fused(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void setStages(const vector<Mat>& kernels);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    Mat performUnfusedConvolution();
+    Mat performParallelUnfusedConvolution();
+    String getStageReport();
+    String test();
+};
@@ -0,0 +1,245 @@
+#include "Convolution_Incremental.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+// Dio jednog izlaznog reda koji treba ponovo izracunati: kolone [begin, end)
+struct RowSpan
+{
+	int row;
+	int begin;
+	int end;
+};
+
+// Izmjene koje test() pravi: broj pravougaonika i njihova stranica u pikselima
+static const int testEditCount = 16;
+static const int testEditSize = 32;
+
+Convolution_Incremental::Convolution_Incremental(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Incremental::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	cachedOutput.release();
+}
+
+void Convolution_Incremental::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Incremental::setInputImage(Mat image)
+{
+	inputImage = image;
+	cachedOutput.release();
+}
+
+vector<Rect> Convolution_Incremental::affectedRegions(const vector<Rect>& changedRegions)
+{
+	int kernelRowsSizeHalf = convolutionKernel.rows / 2;
+	int kernelColsSizeHalf = convolutionKernel.cols / 2;
+	Rect image(0, 0, inputImage.cols, inputImage.rows);
+
+	vector<Rect> regions;
+	for (const Rect& changed : changedRegions) {
+		Rect region = changed & image;
+		if (region.empty()) {
+			continue;
+		}
+
+		// Izlazni pikseli udaljeni najvise pola kernela od izmjene; sa jednim odrazom ili jednim
+		// ponavljanjem slike to vazi i za ivice, a kernel siri od slike zahvata cijelu osu
+		region.x -= kernelColsSizeHalf;
+		region.width += 2 * kernelColsSizeHalf;
+		region.y -= kernelRowsSizeHalf;
+		region.height += 2 * kernelRowsSizeHalf;
+		if (kernelColsSizeHalf > inputImage.cols - 1) {
+			region.x = 0;
+			region.width = inputImage.cols;
+		}
+		if (kernelRowsSizeHalf > inputImage.rows - 1) {
+			region.y = 0;
+			region.height = inputImage.rows;
+		}
+
+		// Kod wrap dio koji izlazi preko ivice pripada pikselima uz suprotnu ivicu
+		int copies = borderMode == BorderWrap ? 1 : 0;
+		for (int dy = -copies; dy <= copies; dy++) {
+			for (int dx = -copies; dx <= copies; dx++) {
+				Rect shifted = (region + Point(dx * inputImage.cols, dy * inputImage.rows)) & image;
+				if (!shifted.empty()) {
+					regions.push_back(shifted);
+				}
+			}
+		}
+	}
+	return regions;
+}
+
+void Convolution_Incremental::convolveRegions(const vector<Rect>& regions, bool parallel)
+{
+	int kernelRowsSizeHalf = convolutionKernel.rows / 2;
+	int kernelColsSizeHalf = convolutionKernel.cols / 2;
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+
+	// Svaki red regiona postaje raspon; rasponi istog reda koji se preklapaju ili dodiruju se spajaju
+	vector<RowSpan> spans;
+	for (const Rect& region : regions) {
+		for (int x = region.y; x < region.y + region.height; x++) {
+			spans.push_back({ x, region.x, region.x + region.width });
+		}
+	}
+	sort(spans.begin(), spans.end(), [](const RowSpan& a, const RowSpan& b) {
+		return a.row != b.row ? a.row < b.row : a.begin < b.begin;
+	});
+	size_t merged = 0;
+	for (size_t k = 0; k < spans.size(); k++) {
+		if (merged > 0 && spans[merged - 1].row == spans[k].row && spans[k].begin <= spans[merged - 1].end) {
+			spans[merged - 1].end = max(spans[merged - 1].end, spans[k].end);
+		}
+		else {
+			spans[merged++] = spans[k];
+		}
+	}
+	spans.resize(merged);
+
+	// Kolone ciji svi tapovi leze u slici citaju izvor direktno, ostale preslikavaju indeks prema ivici
+	int firstInterior = min(kernelColsSizeHalf, cols);
+	int lastInterior = max(cols - kernelColsSizeHalf, firstInterior);
+
+	forEachIndex((int)spans.size(), parallel, [&](int k) {
+		const RowSpan& span = spans[k];
+		int width = span.end - span.begin;
+
+		// Tapovi se za svaki piksel sabiraju redom (u, v), kao u direktnoj petlji osnovnih varijanti
+		thread_local vector<double> accumulator;
+		accumulator.assign(3 * (size_t)width, 0.0);
+		int interiorBegin = min(max(span.begin, firstInterior), span.end);
+		int interiorEnd = max(min(span.end, lastInterior), interiorBegin);
+
+		for (int u = 0; u < convolutionKernel.rows; u++) {
+			int sourceRow = mapBorderIndex(span.row + u - kernelRowsSizeHalf, rows, borderMode);
+			if (sourceRow < 0) {
+				continue;
+			}
+			const uchar* row = inputImage.ptr<uchar>(sourceRow);
+			const double* taps = convolutionKernel.ptr<double>(u);
+
+			for (int v = 0; v < convolutionKernel.cols; v++) {
+				double weight = taps[v];
+				int offset = v - kernelColsSizeHalf;
+
+				for (int y = interiorBegin; y < interiorEnd; y++) {
+					const uchar* pixel = row + 3 * (y + offset);
+					double* sum = &accumulator[3 * (size_t)(y - span.begin)];
+					sum[0] += pixel[0] * weight;
+					sum[1] += pixel[1] * weight;
+					sum[2] += pixel[2] * weight;
+				}
+				// Najvise pola kernela kolona sa svake strane
+				auto addEdgeColumns = [&](int first, int last) {
+					for (int y = first; y < last; y++) {
+						int sourceCol = mapBorderIndex(y + offset, cols, borderMode);
+						if (sourceCol >= 0) {
+							const uchar* pixel = row + 3 * sourceCol;
+							double* sum = &accumulator[3 * (size_t)(y - span.begin)];
+							sum[0] += pixel[0] * weight;
+							sum[1] += pixel[1] * weight;
+							sum[2] += pixel[2] * weight;
+						}
+					}
+				};
+				addEdgeColumns(span.begin, interiorBegin);
+				addEdgeColumns(interiorEnd, span.end);
+			}
+		}
+
+		uchar* destination = cachedOutput.ptr<uchar>(span.row) + 3 * span.begin;
+		for (int i = 0; i < 3 * width; i++) {
+			destination[i] = saturate_cast<uchar>(accumulator[i]);
+		}
+	});
+}
+
+Mat Convolution_Incremental::performConvolution()
+{
+	cachedOutput.create(inputImage.rows, inputImage.cols, CV_8UC3);
+	convolveRegions({ Rect(0, 0, inputImage.cols, inputImage.rows) }, false);
+	return cachedOutput;
+}
+
+Mat Convolution_Incremental::performParallelConvolution()
+{
+	cachedOutput.create(inputImage.rows, inputImage.cols, CV_8UC3);
+	convolveRegions({ Rect(0, 0, inputImage.cols, inputImage.rows) }, true);
+	return cachedOutput;
+}
+
+Mat Convolution_Incremental::performIncrementalConvolution(const vector<Rect>& changedRegions, bool parallel)
+{
+	if (inputImage.type() != CV_8UC3) {
+		throw invalid_argument("Ulazna slika mora biti CV_8UC3");
+	}
+	if (cachedOutput.size() != inputImage.size()) {
+		return parallel ? performParallelConvolution() : performConvolution();
+	}
+	convolveRegions(affectedRegions(changedRegions), parallel);
+	return cachedOutput;
+}
+
+String Convolution_Incremental::test()
+{
+	// Izmjene se prave nad kopijom, da ulazna slika ostane ista za ostale pozive
+	Mat original = inputImage;
+	inputImage = original.clone();
+
+	mt19937 generator(7);
+	vector<Rect> edits;
+	for (int i = 0; i < testEditCount; i++) {
+		int x = (int)(generator() % max(inputImage.cols - testEditSize + 1, 1));
+		int y = (int)(generator() % max(inputImage.rows - testEditSize + 1, 1));
+		edits.push_back(Rect(x, y, testEditSize, testEditSize) & Rect(0, 0, inputImage.cols, inputImage.rows));
+	}
+	// Izmjena je invertovanje piksela pravougaonika, pa se slika svakim pozivom zaista mijenja
+	auto applyEdits = [this, &edits]() {
+		for (const Rect& edit : edits) {
+			for (int x = edit.y; x < edit.y + edit.height; x++) {
+				uchar* pixel = inputImage.ptr<uchar>(x) + 3 * edit.x;
+				for (int i = 0; i < 3 * edit.width; i++) {
+					pixel[i] = 255 - pixel[i];
+				}
+			}
+		}
+	};
+
+	String description = to_string(testEditCount) + " izmjena " + to_string(testEditSize) + " x " + to_string(testEditSize) + ", " + getBorderModeName(borderMode);
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nPuna konvolucija (" + getBorderModeName(borderMode) + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nPuna konvolucija (" + getBorderModeName(borderMode) + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	log += "\nInkrementalna konvolucija (" + description + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([&]() { applyEdits(); return performIncrementalConvolution(edits, false); });
+	log += "\nInkrementalna konvolucija (" + description + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([&]() { applyEdits(); return performIncrementalConvolution(edits, true); });
+
+	inputImage = original;
+	cachedOutput.release();
+	return log;
+}
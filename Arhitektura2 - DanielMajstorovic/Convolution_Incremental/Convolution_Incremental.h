@@ -0,0 +1,42 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Inkrementalna konvolucija za interaktivne izmjene malih dijelova velike slike. Puna konvolucija
+// cuva rezultat; performIncrementalConvolution zatim prima pravougaonike ulaza koji su izmijenjeni,
+// prosiruje ih za pola kernela (svi izlazni pikseli ciji kernel dodiruje izmjenu) i racuna samo njih,
+// direktno u sacuvani rezultat. Preklapanja se rastavljaju po redovima u disjunktne raspone, pa se
+// nijedan piksel ne racuna dvaput, i vrijeme zavisi od izmijenjene povrsine, a ne od velicine slike.
+// Ivice prema --border=zero|replicate|reflect101|wrap; kod wrap izmjena uz ivicu mijenja i piksele
+// uz suprotnu ivicu. Rezultat je isti kao kod osnovnih varijanti nad izmijenjenom slikom.
+class Convolution_Incremental
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    BorderMode borderMode;
+    Mat cachedOutput;
+
+    vector<Rect> affectedRegions(const vector<Rect>& changedRegions);
+    void convolveRegions(const vector<Rect>& regions, bool parallel);
+
+public:
+    Convolution_Incremental(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    // Slika dijeli podatke sa pozivaocem, pa se izmjene upisuju direktno u nju; sacuvani rezultat se brise
+    void setInputImage(Mat image);
+    // Puna konvolucija; rezultat postaje osnova za inkrementalne pozive
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    // Ponovo racuna samo okolinu izmijenjenih pravougaonika ulaza (bez sacuvanog rezultata racuna sve).
+    // Vraca sacuvani rezultat, koji sljedeci poziv mijenja; pozivalac koji ga cuva duze mora ga klonirati
+    Mat performIncrementalConvolution(const vector<Rect>& changedRegions, bool parallel);
+    String test();
+};
@@ -0,0 +1,310 @@
+#include "Convolution_MixedPrecision.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+
+StoragePrecision parseStoragePrecision(const string& name)
+{
+	if (name == "f64") {
+		return StorageFloat64;
+	}
+	if (name == "f32") {
+		return StorageFloat32;
+	}
+	if (name == "f16") {
+		return StorageFloat16;
+	}
+	if (name == "bf16") {
+		return StorageBfloat16;
+	}
+	throw invalid_argument("Opcija --storage mora biti f64, f32, f16 ili bf16");
+}
+
+string getStoragePrecisionName(StoragePrecision precision)
+{
+	switch (precision) {
+	case StorageFloat64: return "f64";
+	case StorageFloat16: return "f16";
+	case StorageBfloat16: return "bf16";
+	default: return "f32";
+	}
+}
+
+AccumulatePrecision parseAccumulatePrecision(const string& name)
+{
+	if (name == "f64") {
+		return AccumulateFloat64;
+	}
+	if (name == "f32") {
+		return AccumulateFloat32;
+	}
+	throw invalid_argument("Opcija --accumulate mora biti f64 ili f32");
+}
+
+string getAccumulatePrecisionName(AccumulatePrecision precision)
+{
+	return precision == AccumulateFloat64 ? "f64" : "f32";
+}
+
+static int getStorageType(StoragePrecision precision)
+{
+	switch (precision) {
+	case StorageFloat64: return CV_64FC3;
+	case StorageFloat32: return CV_32FC3;
+	// Bitovi float16 i bfloat16 cuvaju se kao 16-bitni cijeli brojevi
+	default: return CV_16UC3;
+	}
+}
+
+Convolution_MixedPrecision::Convolution_MixedPrecision(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_MixedPrecision::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	storage = parseStoragePrecision(arguments.getOption("storage", "f16"));
+	accumulate = parseAccumulatePrecision(arguments.getOption("accumulate", "f32"));
+
+	floatTaps.resize(convolutionKernel.rows * convolutionKernel.cols);
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			floatTaps[u * convolutionKernel.cols + v] = (float)convolutionKernel.at<double>(u, v);
+		}
+	}
+
+	// --isa ima prednost nad promjenljivom CONV_ISA; konverzije float16 postoje samo za AVX2 (F16C)
+	isa = selectIsaLevel(arguments.getOption("isa", ""));
+	conversions = isa >= IsaAvx2 ? avx2HalfRowConversions : scalarHalfRowConversions;
+}
+
+void Convolution_MixedPrecision::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_MixedPrecision::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+template <typename Accumulator>
+void Convolution_MixedPrecision::accumulateRow(int x, const Accumulator* taps, Accumulator* sums)
+{
+	int kernelRowsSizeHalf = convolutionKernel.rows / 2;
+	int kernelColsSizeHalf = convolutionKernel.cols / 2;
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+
+	// Kolone ciji svi tapovi leze u slici citaju izvor direktno, ostale preslikavaju indeks prema ivici
+	int firstInterior = min(kernelColsSizeHalf, cols);
+	int lastInterior = max(cols - kernelColsSizeHalf, firstInterior);
+
+	// Tapovi se za svaki piksel sabiraju redom (u, v), kao u direktnoj petlji osnovnih varijanti
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		int sourceRow = mapBorderIndex(x + u - kernelRowsSizeHalf, rows, borderMode);
+		if (sourceRow < 0) {
+			continue;
+		}
+		const uchar* row = inputImage.ptr<uchar>(sourceRow);
+
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			Accumulator weight = taps[u * convolutionKernel.cols + v];
+			int offset = v - kernelColsSizeHalf;
+
+			const uchar* shifted = row + 3 * offset;
+			for (int i = 3 * firstInterior; i < 3 * lastInterior; i++) {
+				sums[i] += shifted[i] * weight;
+			}
+			// Najvise pola kernela kolona sa svake strane
+			auto addEdgeColumns = [&](int first, int last) {
+				for (int y = first; y < last; y++) {
+					int sourceCol = mapBorderIndex(y + offset, cols, borderMode);
+					if (sourceCol >= 0) {
+						const uchar* pixel = row + 3 * sourceCol;
+						Accumulator* sum = sums + 3 * y;
+						sum[0] += pixel[0] * weight;
+						sum[1] += pixel[1] * weight;
+						sum[2] += pixel[2] * weight;
+					}
+				}
+			};
+			addEdgeColumns(0, firstInterior);
+			addEdgeColumns(lastInterior, cols);
+		}
+	}
+}
+
+void Convolution_MixedPrecision::storeRow(int x, StoragePrecision precision, const double* wideSums, const float* narrowSums)
+{
+	int samples = 3 * inputImage.cols;
+
+	if (precision == StorageFloat64) {
+		double* destination = storedResult.ptr<double>(x);
+		for (int i = 0; i < samples; i++) {
+			destination[i] = wideSums != nullptr ? wideSums[i] : narrowSums[i];
+		}
+		return;
+	}
+
+	// Uzi formati se pune iz float reda
+	thread_local vector<float> narrowed;
+	if (narrowSums == nullptr) {
+		narrowed.resize(samples);
+		for (int i = 0; i < samples; i++) {
+			narrowed[i] = (float)wideSums[i];
+		}
+		narrowSums = narrowed.data();
+	}
+
+	switch (precision) {
+	case StorageFloat32:
+		memcpy(storedResult.ptr<float>(x), narrowSums, samples * sizeof(float));
+		break;
+	case StorageFloat16:
+		conversions.storeFloat16(narrowSums, samples, storedResult.ptr<ushort>(x));
+		break;
+	default:
+		conversions.storeBfloat16(narrowSums, samples, storedResult.ptr<ushort>(x));
+		break;
+	}
+}
+
+void Convolution_MixedPrecision::loadRow(int x, StoragePrecision precision, uchar* destination)
+{
+	int samples = 3 * inputImage.cols;
+
+	// Zaokruzivanje i saturacija kao convertTo(CV_8UC3)
+	if (precision == StorageFloat64) {
+		const double* source = storedResult.ptr<double>(x);
+		for (int i = 0; i < samples; i++) {
+			destination[i] = saturate_cast<uchar>(source[i]);
+		}
+		return;
+	}
+
+	const float* source = storedResult.ptr<float>(x);
+	thread_local vector<float> widened;
+	if (precision != StorageFloat32) {
+		widened.resize(samples);
+		if (precision == StorageFloat16) {
+			conversions.loadFloat16(storedResult.ptr<ushort>(x), samples, widened.data());
+		}
+		else {
+			conversions.loadBfloat16(storedResult.ptr<ushort>(x), samples, widened.data());
+		}
+		source = widened.data();
+	}
+	for (int i = 0; i < samples; i++) {
+		destination[i] = saturate_cast<uchar>(source[i]);
+	}
+}
+
+Mat Convolution_MixedPrecision::convolve(StoragePrecision storagePrecision, AccumulatePrecision accumulatePrecision, bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int samples = 3 * cols;
+
+	// Baferi se alociraju samo kada se promijeni oblik ili format
+	storedResult.create(rows, cols, getStorageType(storagePrecision));
+	outputImage.create(rows, cols, CV_8UC3);
+
+	// Prvi prolaz: sabiranje tapova u redu akumulatora pa upis medjurezultata
+	forEachIndex(rows, parallel, [&](int x) {
+		if (accumulatePrecision == AccumulateFloat64) {
+			thread_local vector<double> sums;
+			sums.assign(samples, 0.0);
+			accumulateRow<double>(x, convolutionKernel.ptr<double>(), sums.data());
+			storeRow(x, storagePrecision, sums.data(), nullptr);
+		}
+		else {
+			thread_local vector<float> sums;
+			sums.assign(samples, 0.0f);
+			accumulateRow<float>(x, floatTaps.data(), sums.data());
+			storeRow(x, storagePrecision, nullptr, sums.data());
+		}
+	});
+
+	// Drugi prolaz: citanje medjurezultata i zaokruzivanje u 8 bita
+	forEachIndex(rows, parallel, [&](int x) {
+		loadRow(x, storagePrecision, outputImage.ptr<uchar>(x));
+	});
+
+	return outputImage;
+}
+
+Mat Convolution_MixedPrecision::performConvolution()
+{
+	return convolve(storage, accumulate, false);
+}
+
+Mat Convolution_MixedPrecision::performParallelConvolution()
+{
+	return convolve(storage, accumulate, true);
+}
+
+// Medjurezultat bilo kog formata kao CV_64FC3, za poredjenje sa f64/f64
+static Mat readStoredResult(const Mat& stored, StoragePrecision precision)
+{
+	Mat values(stored.rows, stored.cols, CV_64FC3);
+	int samples = 3 * stored.cols;
+	for (int x = 0; x < stored.rows; x++) {
+		double* destination = values.ptr<double>(x);
+		for (int i = 0; i < samples; i++) {
+			switch (precision) {
+			case StorageFloat64: destination[i] = stored.ptr<double>(x)[i]; break;
+			case StorageFloat32: destination[i] = stored.ptr<float>(x)[i]; break;
+			case StorageFloat16: destination[i] = float16ToFloat(stored.ptr<ushort>(x)[i]); break;
+			default: destination[i] = bfloat16ToFloat(stored.ptr<ushort>(x)[i]); break;
+			}
+		}
+	}
+	return values;
+}
+
+String Convolution_MixedPrecision::test()
+{
+	String policy = "cuvanje " + getStoragePrecisionName(storage) + ", sabiranje " + getAccumulatePrecisionName(accumulate) + ", " + getIsaLevelName(isa);
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nMjesovita preciznost (" + policy + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nMjesovita preciznost (" + policy + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+
+	// Referenca je f64/f64, isti rezultat kao osnovne varijante
+	Mat referenceOutput = convolve(StorageFloat64, AccumulateFloat64, true).clone();
+	Mat referenceValues = storedResult.clone();
+
+	const StoragePrecision storages[] = { StorageFloat64, StorageFloat32, StorageFloat16, StorageBfloat16 };
+	const AccumulatePrecision accumulators[] = { AccumulateFloat64, AccumulateFloat32 };
+	for (StoragePrecision storagePrecision : storages) {
+		for (AccumulatePrecision accumulatePrecision : accumulators) {
+			log += "\nMjesovita preciznost (cuvanje " + getStoragePrecisionName(storagePrecision) + " " + to_string(CV_ELEM_SIZE(getStorageType(storagePrecision))) + " B/piksel, sabiranje ";
+			log += getAccumulatePrecisionName(accumulatePrecision) + "), paralelno izvrsavanje: ";
+			log += measureExecutionTime([&]() { return convolve(storagePrecision, accumulatePrecision, true); });
+
+			Mat output = convolve(storagePrecision, accumulatePrecision, true);
+			double valueError = norm(readStoredResult(storedResult, storagePrecision), referenceValues, NORM_INF);
+			double outputError = norm(output, referenceOutput, NORM_INF);
+			// Greska f32 je mnogo manja od 1e-6, pa se ispisuje sa znacajnim ciframa umjesto fiksnih decimala
+			ostringstream valueText;
+			valueText << valueError;
+			log += " Najveca greska medjurezultata: " + valueText.str() + ", izlaza: " + to_string((int)outputError) + " nivoa";
+		}
+	}
+	return log;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+#include "CpuFeatures.h"
+#include "MixedPrecisionKernels.h"
+
+using namespace cv;
+using namespace std;
+
+// Format medjurezultata (--storage=f64|f32|f16|bf16): bajtova po pikselu 24, 12, 6 i 6
+enum StoragePrecision
+{
+    StorageFloat64,
+    StorageFloat32,
+    StorageFloat16,
+    StorageBfloat16
+};
+
+// Tip u kome se sabiraju tapovi jednog piksela (--accumulate=f64|f32)
+enum AccumulatePrecision
+{
+    AccumulateFloat64,
+    AccumulateFloat32
+};
+
+// Isti tok kao pet osnovnih varijanti: prvi prolaz sabira tapove svakog piksela i upisuje
+// medjurezultat velicine slike, drugi ga cita i zaokruzuje u CV_8UC3. Osnovne varijante i sabiraju
+// i cuvaju u CV_64FC3 (24 bajta po pikselu u oba prolaza), sto je za 8-bitni izlaz mnogo vise
+// preciznosti nego sto treba, a na velikim slikama oba prolaza ogranicava propusnost memorije.
+// Ovdje se tip sabiranja i format medjurezultata biraju posebno; float16 i bfloat16 se pretvaraju
+// pri upisu i citanju reda (F16C i AVX2, ili skalarno kada ih procesor nema, --isa kao kod planarne
+// varijante). f64/f64 daje isti rezultat kao osnovne varijante; test() za svaku kombinaciju mjeri
+// vrijeme i najvecu gresku medjurezultata i izlaza u odnosu na f64/f64.
+// Ivice prema --border=zero|replicate|reflect101|wrap.
+class Convolution_MixedPrecision
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    BorderMode borderMode;
+    StoragePrecision storage;
+    AccumulatePrecision accumulate;
+    IsaLevel isa;
+    HalfRowConversions conversions;
+    vector<float> floatTaps;
+    Mat storedResult;
+    Mat outputImage;
+
+    template <typename Accumulator>
+    void accumulateRow(int x, const Accumulator* taps, Accumulator* sums);
+    // Red sabran u double (wideSums) ili float (narrowSums), drugi je nullptr
+    void storeRow(int x, StoragePrecision precision, const double* wideSums, const float* narrowSums);
+    void loadRow(int x, StoragePrecision precision, uchar* destination);
+    Mat convolve(StoragePrecision storagePrecision, AccumulatePrecision accumulatePrecision, bool parallel);
+
+public:
+    Convolution_MixedPrecision(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
+
+StoragePrecision parseStoragePrecision(const string& name);
+string getStoragePrecisionName(StoragePrecision precision);
+AccumulatePrecision parseAccumulatePrecision(const string& name);
+string getAccumulatePrecisionName(AccumulatePrecision precision);
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstring>
+#include <cmath>
+
+typedef unsigned short ushort;
+
+// Pretvaranje reda float vrijednosti u 16-bitne formate i nazad. float16 (IEEE binary16) ima 11 bita
+// mantise i opseg do 65504; bfloat16 je gornja polovina float32 (8 bita mantise, isti opseg kao float).
+// Oba smjera zaokruzuju na najblizi paran, pa skalarna i vektorska verzija daju iste bitove.
+typedef void (*StoreHalfRowFunction)(const float* source, int count, ushort* destination);
+typedef void (*LoadHalfRowFunction)(const ushort* source, int count, float* destination);
+
+struct HalfRowConversions
+{
+    StoreHalfRowFunction storeFloat16;
+    LoadHalfRowFunction loadFloat16;
+    StoreHalfRowFunction storeBfloat16;
+    LoadHalfRowFunction loadBfloat16;
+};
+
+// Vektorska verzija je u posebnom fajlu koji se prevodi za AVX2 i F16C (u vcxproj-u
+// EnableEnhancedInstructionSet, za GCC/Clang atribut target), kao kod planarne varijante
+#if defined(__GNUC__) || defined(__clang__)
+#define MIXED_PRECISION_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MIXED_PRECISION_TARGET(isa)
+#endif
+
+extern const HalfRowConversions scalarHalfRowConversions;
+extern const HalfRowConversions avx2HalfRowConversions;
+
+inline unsigned int floatBits(float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bitsToFloat(unsigned int bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline ushort floatToFloat16(float value)
+{
+    unsigned int bits = floatBits(value);
+    unsigned int sign = (bits >> 16) & 0x8000;
+    unsigned int magnitude = bits & 0x7FFFFFFF;
+    if (magnitude > 0x7F800000) {
+        return (ushort)(sign | 0x7E00);
+    }
+    // 65520 i vise se zaokruzuje na beskonacnost
+    if (magnitude >= 0x477FF000) {
+        return (ushort)(sign | 0x7C00);
+    }
+    // Ispod 2^-14 su subnormalni brojevi: vrijednost x 2^24 je tacna, a nearbyint zaokruzuje na paran
+    if (magnitude < 0x38800000) {
+        return (ushort)(sign | (unsigned int)nearbyintf(bitsToFloat(magnitude) * 16777216.0f));
+    }
+    unsigned int rounded = magnitude + 0xFFF + ((magnitude >> 13) & 1);
+    return (ushort)(sign | ((rounded - 0x38000000) >> 13));
+}
+
+inline float float16ToFloat(ushort half)
+{
+    unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+    unsigned int exponent = (half >> 10) & 0x1F;
+    unsigned int mantissa = half & 0x3FF;
+    if (exponent == 0) {
+        float value = mantissa / 16777216.0f;
+        return sign != 0 ? -value : value;
+    }
+    if (exponent == 31) {
+        return bitsToFloat(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+// NaN se ne cuva posebno: konvolucija konacne slike ga ne daje
+inline ushort floatToBfloat16(float value)
+{
+    unsigned int bits = floatBits(value);
+    return (ushort)((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+}
+
+inline float bfloat16ToFloat(ushort value)
+{
+    return bitsToFloat((unsigned int)value << 16);
+}
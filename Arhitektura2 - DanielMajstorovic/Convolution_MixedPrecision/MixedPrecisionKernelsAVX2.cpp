@@ -0,0 +1,70 @@
+#include "MixedPrecisionKernels.h"
+#include <immintrin.h>
+
+// Po 8 vrijednosti u jednoj instrukciji konverzije (F16C) ili nekoliko cjelobrojnih (bfloat16);
+// ostatak reda ide skalarnom konverzijom, koja daje iste bitove
+
+MIXED_PRECISION_TARGET("avx2,f16c")
+static void storeFloat16RowAvx2(const float* source, int count, ushort* destination)
+{
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128((__m128i*)(destination + i), half);
+	}
+	for (; i < count; i++) {
+		destination[i] = floatToFloat16(source[i]);
+	}
+}
+
+MIXED_PRECISION_TARGET("avx2,f16c")
+static void loadFloat16RowAvx2(const ushort* source, int count, float* destination)
+{
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(destination + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(source + i))));
+	}
+	for (; i < count; i++) {
+		destination[i] = float16ToFloat(source[i]);
+	}
+}
+
+MIXED_PRECISION_TARGET("avx2")
+static void storeBfloat16RowAvx2(const float* source, int count, ushort* destination)
+{
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i bias = _mm256_set1_epi32(0x7FFF);
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		// Zaokruzivanje na paran: dodaje se 0x7FFF i najnizi zadrzani bit, pa se uzima gornjih 16 bita
+		__m256i bits = _mm256_castps_si256(_mm256_loadu_ps(source + i));
+		__m256i lowestKept = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+		__m256i upper = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(bias, lowestKept)), 16);
+		// Pakovanje radi po 128-bitnim polovinama, pa se 64-bitni dijelovi preuredjuju u red
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(upper, upper), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm_storeu_si128((__m128i*)(destination + i), _mm256_castsi256_si128(packed));
+	}
+	for (; i < count; i++) {
+		destination[i] = floatToBfloat16(source[i]);
+	}
+}
+
+MIXED_PRECISION_TARGET("avx2")
+static void loadBfloat16RowAvx2(const ushort* source, int count, float* destination)
+{
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i widened = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(source + i)));
+		_mm256_storeu_ps(destination + i, _mm256_castsi256_ps(_mm256_slli_epi32(widened, 16)));
+	}
+	for (; i < count; i++) {
+		destination[i] = bfloat16ToFloat(source[i]);
+	}
+}
+
+const HalfRowConversions avx2HalfRowConversions = {
+	storeFloat16RowAvx2,
+	loadFloat16RowAvx2,
+	storeBfloat16RowAvx2,
+	loadBfloat16RowAvx2
+};
@@ -0,0 +1,37 @@
+#include "MixedPrecisionKernels.h"
+
+// Rezervna verzija bez F16C, bit po bit ista kao vektorska
+static void storeFloat16RowScalar(const float* source, int count, ushort* destination)
+{
+	for (int i = 0; i < count; i++) {
+		destination[i] = floatToFloat16(source[i]);
+	}
+}
+
+static void loadFloat16RowScalar(const ushort* source, int count, float* destination)
+{
+	for (int i = 0; i < count; i++) {
+		destination[i] = float16ToFloat(source[i]);
+	}
+}
+
+static void storeBfloat16RowScalar(const float* source, int count, ushort* destination)
+{
+	for (int i = 0; i < count; i++) {
+		destination[i] = floatToBfloat16(source[i]);
+	}
+}
+
+static void loadBfloat16RowScalar(const ushort* source, int count, float* destination)
+{
+	for (int i = 0; i < count; i++) {
+		destination[i] = bfloat16ToFloat(source[i]);
+	}
+}
+
+const HalfRowConversions scalarHalfRowConversions = {
+	storeFloat16RowScalar,
+	loadFloat16RowScalar,
+	storeBfloat16RowScalar,
+	loadBfloat16RowScalar
+};
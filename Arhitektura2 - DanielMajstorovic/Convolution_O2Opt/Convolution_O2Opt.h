@@ -2,22 +2,38 @@
 #include <opencv2/opencv.hpp>
 #include <opencv2/highgui.hpp>
 #include <omp.h>
+#include <memory>
+#include "BorderHandling.h"
+#include "KernelProgram.h"
 
 using namespace cv;
 using namespace std;
 
+class ConvolutionWorkspace;
+
 class Convolution_O2Opt
 {
     char* inputFilePath;
     char* outputFilePath;
     Mat convolutionKernel;
     Mat inputImage;
+    shared_ptr<ConvolutionWorkspace> workspace;
+    BorderMode borderMode;
+    KernelProgram kernelProgram;
+
+    Mat tiledConvolution(bool parallel);
 
 public:
     Convolution_O2Opt(int argc, char* argv[]);
     void readArguments(int argc, char* argv[]);
     void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Baferi se zadrzavaju izmedju poziva; vraceni rezultat vazi do sljedeceg poziva (ConvolutionWorkspace)
+    void setWorkspace(shared_ptr<ConvolutionWorkspace> sharedWorkspace);
     Mat performConvolution();
     Mat performParallelConvolution();
+    // Ista konvolucija kao gore, izvrsena po blokovima izabranim prema velicini kernela i kesa
+    Mat performTiledConvolution();
+    Mat performParallelTiledConvolution();
     String test();
 };
@@ -0,0 +1,148 @@
+#include "Convolution_Planar.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+Convolution_Planar::Convolution_Planar(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Planar::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+
+	kernelTaps.resize(convolutionKernel.rows * convolutionKernel.cols);
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			kernelTaps[u * convolutionKernel.cols + v] = (float)convolutionKernel.at<double>(u, v);
+		}
+	}
+
+	// --isa ima prednost nad promjenljivom CONV_ISA; bez oba se bira najsira podrzana verzija
+	isa = selectIsaLevel(arguments.getOption("isa", ""));
+	switch (isa) {
+	case IsaAvx512:
+		rowFunction = convolvePlanarRowAvx512;
+		break;
+	case IsaAvx2:
+		rowFunction = convolvePlanarRowAvx2;
+		break;
+	case IsaSse41:
+		rowFunction = convolvePlanarRowSse41;
+		break;
+	default:
+		rowFunction = convolvePlanarRowScalar;
+		break;
+	}
+}
+
+void Convolution_Planar::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Planar::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_Planar::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+void Convolution_Planar::preparePlanes(vector<Mat>& planes, bool parallel)
+{
+	int half = convolutionKernel.rows / 2;
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+
+	// Sirina je zaokruzena na 32 piksela da posljednja iteracija reda cita samo nule, bez posebnog repa
+	int paddedCols = (cols + planarColumnAlignment - 1) / planarColumnAlignment * planarColumnAlignment + 2 * half;
+
+	planes.resize(3);
+	for (int c = 0; c < 3; c++) {
+		planes[c] = Mat(rows + 2 * half, paddedCols, CV_32F, Scalar(0));
+	}
+
+	// Kolone prosirenja preslikane u sliku; -1 ostaje nula
+	vector<int> sourceCols(cols + 2 * half);
+	for (int j = 0; j < (int)sourceCols.size(); j++) {
+		sourceCols[j] = mapBorderIndex(j - half, cols, borderMode);
+	}
+
+	// Razdvajanje BGR piksela u tri ravni uz konverziju u float, zajedno sa prosirenjem
+	forEachIndex(rows + 2 * half, parallel, [&](int i) {
+		int sourceRow = mapBorderIndex(i - half, rows, borderMode);
+		if (sourceRow < 0) {
+			return;
+		}
+		const uchar* source = inputImage.ptr<uchar>(sourceRow);
+		float* blue = planes[0].ptr<float>(i);
+		float* green = planes[1].ptr<float>(i);
+		float* red = planes[2].ptr<float>(i);
+		for (int j = 0; j < (int)sourceCols.size(); j++) {
+			int y = sourceCols[j];
+			if (y < 0) {
+				continue;
+			}
+			blue[j] = source[3 * y];
+			green[j] = source[3 * y + 1];
+			red[j] = source[3 * y + 2];
+		}
+	});
+}
+
+void Convolution_Planar::convolveRow(const vector<Mat>& planes, int x, uchar* destination)
+{
+	const float* planeRows[3] = { planes[0].ptr<float>(x), planes[1].ptr<float>(x), planes[2].ptr<float>(x) };
+	rowFunction(planeRows, planes[0].step1(), kernelTaps.data(), convolutionKernel.rows, inputImage.cols, destination);
+}
+
+Mat Convolution_Planar::performConvolution()
+{
+	vector<Mat> planes;
+	preparePlanes(planes, false);
+
+	Mat resultImage = outputBuffer;
+	resultImage.create(inputImage.rows, inputImage.cols, CV_8UC3);
+	for (int x = 0; x < inputImage.rows; x++) {
+		convolveRow(planes, x, resultImage.ptr<uchar>(x));
+	}
+	return resultImage;
+}
+
+Mat Convolution_Planar::performParallelConvolution()
+{
+	vector<Mat> planes;
+	preparePlanes(planes, true);
+
+	Mat resultImage = outputBuffer;
+	resultImage.create(inputImage.rows, inputImage.cols, CV_8UC3);
+	forEachIndex(inputImage.rows, true, [&](int x) {
+		convolveRow(planes, x, resultImage.ptr<uchar>(x));
+	});
+	return resultImage;
+}
+
+String Convolution_Planar::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nPlanarni float32 (" + getIsaLevelName(isa) + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nPlanarni float32 (" + getIsaLevelName(isa) + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	return log;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "CpuFeatures.h"
+#include "BorderHandling.h"
+#include "PlanarKernels.h"
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija nad planarnim (SoA) float32 kanalima: jedan registar sadrzi susjedne izlazne piksele
+// istog kanala, pa je svaki tap kernela jedan broadcast koeficijenta i jedno uzastopno ucitavanje
+// po kanalu. Ravni su prosirene za pola kernela sa svake strane prema --border=zero|replicate|reflect101|wrap.
+// Petlja reda postoji u verzijama za SSE4.1, AVX2/FMA i AVX-512 (PlanarKernels.h); pri pokretanju
+// se preko CPUID bira najsira koju procesor podrzava, a --isa=scalar|sse4.1|avx2|avx512 ili
+// promjenljiva CONV_ISA je mogu zadati rucno radi poredjenja.
+// Za cjelobrojne kernele rezultat je identican double varijantama; za razlomljene se zbog
+// float akumulacije moze razlikovati za 1 nivo kada je vrijednost na granici zaokruzivanja
+// (AVX2 i AVX-512 daju isti rezultat, SSE4.1 i skalarna verzija nemaju FMA).
+class Convolution_Planar
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    Mat outputBuffer;
+    vector<float> kernelTaps;
+    IsaLevel isa;
+    PlanarRowFunction rowFunction;
+    BorderMode borderMode;
+
+    void preparePlanes(vector<Mat>& planes, bool parallel);
+    void convolveRow(const vector<Mat>& planes, int x, uchar* destination);
+
+public:
+    Convolution_Planar(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+
+typedef unsigned char uchar;
+
+// Ravni su prosirene do umnoska 32 piksela, najsire iteracije (AVX-512: 2 x 16), pa nijedna
+// verzija ne treba poseban rep reda
+static const int planarColumnAlignment = 32;
+
+// Racuna jedan izlazni red: planeRows[c] pokazuje na prvi red prozora kanala c, planeStride je
+// razmak redova u float elementima, taps je kernel velicine kernelSize x kernelSize po redovima
+typedef void (*PlanarRowFunction)(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination);
+
+// Svaka verzija je u posebnom fajlu koji se prevodi za svoj skup instrukcija (u vcxproj-u
+// EnableEnhancedInstructionSet po fajlu, za GCC/Clang atribut target), a ostatak programa
+// ostaje preveden bez zahtjeva, pa se izbor vrsi tek pri pokretanju
+#if defined(__GNUC__) || defined(__clang__)
+#define PLANAR_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PLANAR_TARGET(isa)
+#endif
+
+void convolvePlanarRowScalar(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination);
+void convolvePlanarRowSse41(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination);
+void convolvePlanarRowAvx2(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination);
+void convolvePlanarRowAvx512(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination);
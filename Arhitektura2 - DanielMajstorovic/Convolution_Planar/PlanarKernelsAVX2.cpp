@@ -0,0 +1,57 @@
+#include "PlanarKernels.h"
+#include <algorithm>
+#include <immintrin.h>
+
+using namespace std;
+
+// Broj izlaznih piksela po iteraciji: dva AVX registra (2 x 8) po kanalu, 6 nezavisnih akumulatora
+static const int pixelsPerIteration = 16;
+
+PLANAR_TARGET("avx2,fma")
+void convolvePlanarRowAvx2(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination)
+{
+	alignas(32) int values[3][pixelsPerIteration];
+
+	for (int y = 0; y < cols; y += pixelsPerIteration) {
+		__m256 blue0 = _mm256_setzero_ps(), blue1 = _mm256_setzero_ps();
+		__m256 green0 = _mm256_setzero_ps(), green1 = _mm256_setzero_ps();
+		__m256 red0 = _mm256_setzero_ps(), red1 = _mm256_setzero_ps();
+
+		for (int u = 0; u < kernelSize; u++) {
+			const float* blueRow = planeRows[0] + u * planeStride + y;
+			const float* greenRow = planeRows[1] + u * planeStride + y;
+			const float* redRow = planeRows[2] + u * planeStride + y;
+			const float* rowTaps = taps + u * kernelSize;
+
+			for (int v = 0; v < kernelSize; v++) {
+				// Jedan broadcast koeficijenta i uzastopna ucitavanja za 16 piksela svakog kanala
+				__m256 weight = _mm256_set1_ps(rowTaps[v]);
+				blue0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(blueRow + v), blue0);
+				blue1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(blueRow + v + 8), blue1);
+				green0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(greenRow + v), green0);
+				green1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(greenRow + v + 8), green1);
+				red0 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(redRow + v), red0);
+				red1 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(redRow + v + 8), red1);
+			}
+		}
+
+		// Zaokruzivanje na najblizi cijeli broj (kao convertTo) i ogranicavanje na 0-255
+		__m256i low = _mm256_setzero_si256();
+		__m256i high = _mm256_set1_epi32(255);
+		_mm256_store_si256((__m256i*)values[0], _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(blue0), low), high));
+		_mm256_store_si256((__m256i*)(values[0] + 8), _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(blue1), low), high));
+		_mm256_store_si256((__m256i*)values[1], _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(green0), low), high));
+		_mm256_store_si256((__m256i*)(values[1] + 8), _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(green1), low), high));
+		_mm256_store_si256((__m256i*)values[2], _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(red0), low), high));
+		_mm256_store_si256((__m256i*)(values[2] + 8), _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(red1), low), high));
+
+		// Vracanje u BGR raspored
+		int count = min(pixelsPerIteration, cols - y);
+		uchar* pixel = destination + 3 * y;
+		for (int i = 0; i < count; i++) {
+			pixel[3 * i] = (uchar)values[0][i];
+			pixel[3 * i + 1] = (uchar)values[1][i];
+			pixel[3 * i + 2] = (uchar)values[2][i];
+		}
+	}
+}
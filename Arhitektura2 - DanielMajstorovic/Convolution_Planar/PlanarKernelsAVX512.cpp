@@ -0,0 +1,55 @@
+#include "PlanarKernels.h"
+#include <algorithm>
+#include <immintrin.h>
+
+using namespace std;
+
+// Dva ZMM registra (2 x 16) po kanalu; isti redoslijed FMA operacija kao AVX2 verzija, pa je
+// rezultat identican
+static const int pixelsPerIteration = 32;
+
+PLANAR_TARGET("avx512f")
+void convolvePlanarRowAvx512(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination)
+{
+	alignas(64) int values[3][pixelsPerIteration];
+
+	for (int y = 0; y < cols; y += pixelsPerIteration) {
+		__m512 blue0 = _mm512_setzero_ps(), blue1 = _mm512_setzero_ps();
+		__m512 green0 = _mm512_setzero_ps(), green1 = _mm512_setzero_ps();
+		__m512 red0 = _mm512_setzero_ps(), red1 = _mm512_setzero_ps();
+
+		for (int u = 0; u < kernelSize; u++) {
+			const float* blueRow = planeRows[0] + u * planeStride + y;
+			const float* greenRow = planeRows[1] + u * planeStride + y;
+			const float* redRow = planeRows[2] + u * planeStride + y;
+			const float* rowTaps = taps + u * kernelSize;
+
+			for (int v = 0; v < kernelSize; v++) {
+				__m512 weight = _mm512_set1_ps(rowTaps[v]);
+				blue0 = _mm512_fmadd_ps(weight, _mm512_loadu_ps(blueRow + v), blue0);
+				blue1 = _mm512_fmadd_ps(weight, _mm512_loadu_ps(blueRow + v + 16), blue1);
+				green0 = _mm512_fmadd_ps(weight, _mm512_loadu_ps(greenRow + v), green0);
+				green1 = _mm512_fmadd_ps(weight, _mm512_loadu_ps(greenRow + v + 16), green1);
+				red0 = _mm512_fmadd_ps(weight, _mm512_loadu_ps(redRow + v), red0);
+				red1 = _mm512_fmadd_ps(weight, _mm512_loadu_ps(redRow + v + 16), red1);
+			}
+		}
+
+		__m512i low = _mm512_setzero_si512();
+		__m512i high = _mm512_set1_epi32(255);
+		_mm512_store_si512(values[0], _mm512_min_epi32(_mm512_max_epi32(_mm512_cvtps_epi32(blue0), low), high));
+		_mm512_store_si512(values[0] + 16, _mm512_min_epi32(_mm512_max_epi32(_mm512_cvtps_epi32(blue1), low), high));
+		_mm512_store_si512(values[1], _mm512_min_epi32(_mm512_max_epi32(_mm512_cvtps_epi32(green0), low), high));
+		_mm512_store_si512(values[1] + 16, _mm512_min_epi32(_mm512_max_epi32(_mm512_cvtps_epi32(green1), low), high));
+		_mm512_store_si512(values[2], _mm512_min_epi32(_mm512_max_epi32(_mm512_cvtps_epi32(red0), low), high));
+		_mm512_store_si512(values[2] + 16, _mm512_min_epi32(_mm512_max_epi32(_mm512_cvtps_epi32(red1), low), high));
+
+		int count = min(pixelsPerIteration, cols - y);
+		uchar* pixel = destination + 3 * y;
+		for (int i = 0; i < count; i++) {
+			pixel[3 * i] = (uchar)values[0][i];
+			pixel[3 * i + 1] = (uchar)values[1][i];
+			pixel[3 * i + 2] = (uchar)values[2][i];
+		}
+	}
+}
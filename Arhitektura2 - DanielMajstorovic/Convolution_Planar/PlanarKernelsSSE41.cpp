@@ -0,0 +1,55 @@
+#include "PlanarKernels.h"
+#include <algorithm>
+#include <immintrin.h>
+
+using namespace std;
+
+// Dva SSE registra (2 x 4) po kanalu; bez FMA, pa se mnozenje i sabiranje zaokruzuju odvojeno
+static const int pixelsPerIteration = 8;
+
+PLANAR_TARGET("sse4.1")
+void convolvePlanarRowSse41(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination)
+{
+	alignas(16) int values[3][pixelsPerIteration];
+
+	for (int y = 0; y < cols; y += pixelsPerIteration) {
+		__m128 blue0 = _mm_setzero_ps(), blue1 = _mm_setzero_ps();
+		__m128 green0 = _mm_setzero_ps(), green1 = _mm_setzero_ps();
+		__m128 red0 = _mm_setzero_ps(), red1 = _mm_setzero_ps();
+
+		for (int u = 0; u < kernelSize; u++) {
+			const float* blueRow = planeRows[0] + u * planeStride + y;
+			const float* greenRow = planeRows[1] + u * planeStride + y;
+			const float* redRow = planeRows[2] + u * planeStride + y;
+			const float* rowTaps = taps + u * kernelSize;
+
+			for (int v = 0; v < kernelSize; v++) {
+				__m128 weight = _mm_set1_ps(rowTaps[v]);
+				blue0 = _mm_add_ps(blue0, _mm_mul_ps(weight, _mm_loadu_ps(blueRow + v)));
+				blue1 = _mm_add_ps(blue1, _mm_mul_ps(weight, _mm_loadu_ps(blueRow + v + 4)));
+				green0 = _mm_add_ps(green0, _mm_mul_ps(weight, _mm_loadu_ps(greenRow + v)));
+				green1 = _mm_add_ps(green1, _mm_mul_ps(weight, _mm_loadu_ps(greenRow + v + 4)));
+				red0 = _mm_add_ps(red0, _mm_mul_ps(weight, _mm_loadu_ps(redRow + v)));
+				red1 = _mm_add_ps(red1, _mm_mul_ps(weight, _mm_loadu_ps(redRow + v + 4)));
+			}
+		}
+
+		// _mm_max_epi32/_mm_min_epi32 su prve SSE4.1 instrukcije u ovoj petlji
+		__m128i low = _mm_setzero_si128();
+		__m128i high = _mm_set1_epi32(255);
+		_mm_store_si128((__m128i*)values[0], _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(blue0), low), high));
+		_mm_store_si128((__m128i*)(values[0] + 4), _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(blue1), low), high));
+		_mm_store_si128((__m128i*)values[1], _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(green0), low), high));
+		_mm_store_si128((__m128i*)(values[1] + 4), _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(green1), low), high));
+		_mm_store_si128((__m128i*)values[2], _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(red0), low), high));
+		_mm_store_si128((__m128i*)(values[2] + 4), _mm_min_epi32(_mm_max_epi32(_mm_cvtps_epi32(red1), low), high));
+
+		int count = min(pixelsPerIteration, cols - y);
+		uchar* pixel = destination + 3 * y;
+		for (int i = 0; i < count; i++) {
+			pixel[3 * i] = (uchar)values[0][i];
+			pixel[3 * i + 1] = (uchar)values[1][i];
+			pixel[3 * i + 2] = (uchar)values[2][i];
+		}
+	}
+}
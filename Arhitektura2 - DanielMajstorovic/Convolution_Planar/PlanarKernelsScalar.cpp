@@ -0,0 +1,23 @@
+#include "PlanarKernels.h"
+#include <cmath>
+
+// Rezervna verzija bez vektorskih instrukcija, isti redoslijed sabiranja kao vektorske
+void convolvePlanarRowScalar(const float* const planeRows[3], size_t planeStride, const float* taps, int kernelSize, int cols, uchar* destination)
+{
+	for (int y = 0; y < cols; y++) {
+		for (int c = 0; c < 3; c++) {
+			float sum = 0;
+			for (int u = 0; u < kernelSize; u++) {
+				const float* row = planeRows[c] + u * planeStride + y;
+				const float* rowTaps = taps + u * kernelSize;
+				for (int v = 0; v < kernelSize; v++) {
+					sum += rowTaps[v] * row[v];
+				}
+			}
+
+			// nearbyint zaokruzuje na najblizi paran kao cvtps_epi32
+			float value = nearbyintf(sum);
+			destination[3 * y + c] = (uchar)(value < 0 ? 0 : (value > 255 ? 255 : value));
+		}
+	}
+}
@@ -0,0 +1,319 @@
+#include "Convolution_RecursiveGaussian.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+RecursiveGaussianCoefficients computeYoungVanVliet(double sigma)
+{
+	if (sigma < 0.5) {
+		throw invalid_argument("Opcija --sigma mora biti bar 0.5");
+	}
+
+	// q prema sigma (Young i van Vliet, jednacine 11b), pa koeficijenti b0 ... b3 (jednacine 8c)
+	double q = sigma >= 2.5 ? 0.98711 * sigma - 0.96330 : 3.97156 - 4.14554 * sqrt(1 - 0.26891 * sigma);
+	double b0 = 1.57825 + 2.44413 * q + 1.4281 * q * q + 0.422205 * q * q * q;
+	double b1 = 2.44413 * q + 2.85619 * q * q + 1.26661 * q * q * q;
+	double b2 = -(1.4281 * q * q + 1.26661 * q * q * q);
+	double b3 = 0.422205 * q * q * q;
+
+	RecursiveGaussianCoefficients coefficients;
+	coefficients.a1 = b1 / b0;
+	coefficients.a2 = b2 / b0;
+	coefficients.a3 = b3 / b0;
+	coefficients.b = 1 - (b1 + b2 + b3) / b0;
+	return coefficients;
+}
+
+// Rekurzija naprijed pa nazad nad length koraka, svaki korak je lanes nezavisnih signala u uzastopnoj
+// memoriji; line ima jos po 3 koraka ispred i iza za stanje filtra na pocetku svakog smjera.
+// Broj signala je konstanta, a koraci se ne preklapaju (__restrict), pa se petlja po signalima
+// vektorizuje bez provjere preklapanja i bez ostatka.
+template <int lanes>
+static void runRecursion(double* line, int length, const RecursiveGaussianCoefficients& coefficients)
+{
+	// Lokalne kopije: inace bi kompajler morao pretpostaviti da upis u line mijenja koeficijente
+	const double b = coefficients.b;
+	const double a1 = coefficients.a1;
+	const double a2 = coefficients.a2;
+	const double a3 = coefficients.a3;
+	double* first = line + 3 * lanes;
+	double* last = first + (size_t)(length - 1) * lanes;
+
+	// Stacionarno stanje za prvi uzorak: pojacanje je 1, pa je izlaz konstantnog signala jednak ulazu
+	for (int h = 1; h <= 3; h++) {
+		copy(first, first + lanes, first - h * lanes);
+	}
+	for (int t = 0; t < length; t++) {
+		double* __restrict current = first + (size_t)t * lanes;
+		const double* __restrict previous1 = current - lanes;
+		const double* __restrict previous2 = current - 2 * lanes;
+		const double* __restrict previous3 = current - 3 * lanes;
+		for (int l = 0; l < lanes; l++) {
+			current[l] = b * current[l] + a1 * previous1[l] + a2 * previous2[l] + a3 * previous3[l];
+		}
+	}
+
+	for (int h = 1; h <= 3; h++) {
+		copy(last, last + lanes, last + h * lanes);
+	}
+	for (int t = length - 1; t >= 0; t--) {
+		double* __restrict current = first + (size_t)t * lanes;
+		const double* __restrict next1 = current + lanes;
+		const double* __restrict next2 = current + 2 * lanes;
+		const double* __restrict next3 = current + 3 * lanes;
+		for (int l = 0; l < lanes; l++) {
+			current[l] = b * current[l] + a1 * next1[l] + a2 * next2[l] + a3 * next3[l];
+		}
+	}
+}
+
+Convolution_RecursiveGaussian::Convolution_RecursiveGaussian(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_RecursiveGaussian::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+
+	// Koeficijenti kernela sa komandne linije se ne koriste, filtar je zadat samo sa sigma
+	sigma = arguments.getDoubleOption("sigma", 20.0);
+	coefficients = computeYoungVanVliet(sigma);
+	padding = (int)ceil(4 * sigma);
+}
+
+void Convolution_RecursiveGaussian::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_RecursiveGaussian::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_RecursiveGaussian::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+void Convolution_RecursiveGaussian::filterRows(bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int paddedCols = cols + 2 * padding;
+	// 8 redova x 3 kanala po koraku rekurzije
+	const int blockRows = 8;
+	const int lanes = 3 * blockRows;
+
+	vector<int> sourceCols(paddedCols);
+	for (int j = 0; j < paddedCols; j++) {
+		sourceCols[j] = mapBorderIndex(j - padding, cols, borderMode);
+	}
+
+	horizontalPass.create(rows, cols, CV_64FC3);
+	int blocks = (rows + blockRows - 1) / blockRows;
+	forEachIndex(blocks, parallel, [&](int block) {
+		int firstRow = block * blockRows;
+		int count = min(blockRows, rows - firstRow);
+
+		// Transponovanje bloka: korak t sadrzi kolonu t - padding svih redova bloka; visak redova su nule
+		thread_local vector<double> line;
+		line.resize((size_t)(paddedCols + 6) * lanes);
+		double* steps = line.data() + 3 * lanes;
+		for (int t = 0; t < paddedCols; t++) {
+			double* step = steps + (size_t)t * lanes;
+			for (int r = 0; r < blockRows; r++) {
+				if (r < count && sourceCols[t] >= 0) {
+					const uchar* pixel = inputImage.ptr<uchar>(firstRow + r) + 3 * sourceCols[t];
+					step[3 * r] = pixel[0];
+					step[3 * r + 1] = pixel[1];
+					step[3 * r + 2] = pixel[2];
+				}
+				else {
+					step[3 * r] = step[3 * r + 1] = step[3 * r + 2] = 0;
+				}
+			}
+		}
+
+		runRecursion<lanes>(line.data(), paddedCols, coefficients);
+
+		// Nazad u redove, bez prosirenja
+		for (int r = 0; r < count; r++) {
+			double* destination = horizontalPass.ptr<double>(firstRow + r);
+			for (int y = 0; y < cols; y++) {
+				const double* step = steps + (size_t)(y + padding) * lanes + 3 * r;
+				destination[3 * y] = step[0];
+				destination[3 * y + 1] = step[1];
+				destination[3 * y + 2] = step[2];
+			}
+		}
+	});
+}
+
+void Convolution_RecursiveGaussian::filterColumns(bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int paddedRows = rows + 2 * padding;
+	int samples = 3 * cols;
+	// Traka od 64 vrijednosti (512 B po redu), pa je cijela traka sa prosirenjem obicno u L2;
+	// posljednja traka se dopunjava nulama do pune sirine
+	const int stripeWidth = 64;
+
+	vector<int> sourceRows(paddedRows);
+	for (int i = 0; i < paddedRows; i++) {
+		sourceRows[i] = mapBorderIndex(i - padding, rows, borderMode);
+	}
+
+	// Novi bafer za svaki poziv osim kada je zadat izlazni: vraceni rezultat ne smije dijeliti
+	// memoriju sa sljedecim (--batch ga jos zapisuje dok se racuna sljedeca slika)
+	outputImage = outputBuffer;
+	outputImage.create(rows, cols, CV_8UC3);
+	int stripes = (samples + stripeWidth - 1) / stripeWidth;
+	forEachIndex(stripes, parallel, [&](int stripe) {
+		int first = stripe * stripeWidth;
+		int width = min(stripeWidth, samples - first);
+
+		thread_local vector<double> line;
+		line.resize((size_t)(paddedRows + 6) * stripeWidth);
+		double* steps = line.data() + 3 * stripeWidth;
+		for (int t = 0; t < paddedRows; t++) {
+			double* step = steps + (size_t)t * stripeWidth;
+			if (sourceRows[t] >= 0) {
+				const double* source = horizontalPass.ptr<double>(sourceRows[t]) + first;
+				copy(source, source + width, step);
+				fill(step + width, step + stripeWidth, 0.0);
+			}
+			else {
+				fill(step, step + stripeWidth, 0.0);
+			}
+		}
+
+		runRecursion<stripeWidth>(line.data(), paddedRows, coefficients);
+
+		for (int x = 0; x < rows; x++) {
+			const double* step = steps + (size_t)(x + padding) * stripeWidth;
+			uchar* destination = outputImage.ptr<uchar>(x) + first;
+			for (int k = 0; k < width; k++) {
+				destination[k] = saturate_cast<uchar>(step[k]);
+			}
+		}
+	});
+}
+
+Mat Convolution_RecursiveGaussian::convolve(bool parallel)
+{
+	filterRows(parallel);
+	filterColumns(parallel);
+	return outputImage;
+}
+
+Mat Convolution_RecursiveGaussian::performConvolution()
+{
+	return convolve(false);
+}
+
+Mat Convolution_RecursiveGaussian::performParallelConvolution()
+{
+	return convolve(true);
+}
+
+Mat Convolution_RecursiveGaussian::directGaussian(bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int radius = padding;
+
+	// Uzorkovan i normalizovan Gausov kernel 2 * radius + 1, primijenjen po redovima pa po kolonama
+	vector<double> taps(2 * radius + 1);
+	double sum = 0;
+	for (int i = -radius; i <= radius; i++) {
+		taps[i + radius] = exp(-0.5 * i * i / (sigma * sigma));
+		sum += taps[i + radius];
+	}
+	for (double& tap : taps) {
+		tap /= sum;
+	}
+
+	Mat rowPass(rows, cols, CV_64FC3);
+	forEachIndex(rows, parallel, [&](int x) {
+		const uchar* source = inputImage.ptr<uchar>(x);
+		double* destination = rowPass.ptr<double>(x);
+		for (int y = 0; y < cols; y++) {
+			double r = 0, g = 0, b = 0;
+			for (int v = -radius; v <= radius; v++) {
+				int sourceCol = mapBorderIndex(y + v, cols, borderMode);
+				if (sourceCol >= 0) {
+					const uchar* pixel = source + 3 * sourceCol;
+					r += pixel[0] * taps[v + radius];
+					g += pixel[1] * taps[v + radius];
+					b += pixel[2] * taps[v + radius];
+				}
+			}
+			destination[3 * y] = r;
+			destination[3 * y + 1] = g;
+			destination[3 * y + 2] = b;
+		}
+	});
+
+	Mat result(rows, cols, CV_8UC3);
+	forEachIndex(rows, parallel, [&](int x) {
+		vector<double> sums(3 * cols, 0.0);
+		for (int u = -radius; u <= radius; u++) {
+			int sourceRow = mapBorderIndex(x + u, rows, borderMode);
+			if (sourceRow < 0) {
+				continue;
+			}
+			const double* source = rowPass.ptr<double>(sourceRow);
+			double weight = taps[u + radius];
+			for (int k = 0; k < 3 * cols; k++) {
+				sums[k] += source[k] * weight;
+			}
+		}
+		uchar* destination = result.ptr<uchar>(x);
+		for (int k = 0; k < 3 * cols; k++) {
+			destination[k] = saturate_cast<uchar>(sums[k]);
+		}
+	});
+	return result;
+}
+
+String Convolution_RecursiveGaussian::test()
+{
+	String description = "sigma " + to_string(sigma) + ", prosirenje " + to_string(padding);
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nRekurzivni Gaus (" + description + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nRekurzivni Gaus (" + description + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+
+	// Direktna separabilna konvolucija ima 2 x (8 sigma + 1) mnozenja po uzorku, pa se mjeri jednom
+	Mat direct;
+	log += "\nDirektni separabilni Gaus (" + to_string(2 * padding + 1) + " tapova), paralelno izvrsavanje: ";
+	log += measureExecutionTime([&]() { direct = directGaussian(true); return direct; }, 0, 1);
+
+	Mat recursive = performParallelConvolution();
+	double differenceSum = 0;
+	for (int x = 0; x < recursive.rows; x++) {
+		const uchar* recursiveRow = recursive.ptr<uchar>(x);
+		const uchar* directRow = direct.ptr<uchar>(x);
+		for (int k = 0; k < 3 * recursive.cols; k++) {
+			differenceSum += abs(recursiveRow[k] - directRow[k]);
+		}
+	}
+	log += " Najvece odstupanje rekurzivnog: " + to_string((int)norm(recursive, direct, NORM_INF));
+	log += " nivoa, prosjecno: " + to_string(differenceSum / recursive.total() / 3);
+	return log;
+}
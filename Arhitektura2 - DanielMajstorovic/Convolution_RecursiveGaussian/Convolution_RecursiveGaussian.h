@@ -0,0 +1,60 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Koeficijenti rekurzivnog filtra Young-van Vliet (1995) za zadato sigma:
+// naprijed w[n] = b x[n] + a1 w[n-1] + a2 w[n-2] + a3 w[n-3], pa nazad isto od kraja prema pocetku.
+// Pojacanje za konstantan signal je 1 (b + a1 + a2 + a3 = 1).
+struct RecursiveGaussianCoefficients
+{
+    double b;
+    double a1;
+    double a2;
+    double a3;
+};
+
+RecursiveGaussianCoefficients computeYoungVanVliet(double sigma);
+
+// Gausovo zamucenje zadato sa --sigma=S umjesto liste koeficijenata: za sigma 20-50 direktni kernel ima
+// 121+ tapova po dimenziji, a rekurzivni filtar ima 2 x 4 mnozenja po uzorku i dimenziji za bilo koje sigma.
+// Horizontalni prolaz uzima blokove od 8 redova i transponuje ih, pa svaki korak rekurzije radi 24 nezavisna
+// signala (8 redova x 3 kanala) u uzastopnoj memoriji; vertikalni prolaz ide red po red preko trake kolona,
+// sa istim rasporedom. Obje petlje po signalima su bez zavisnosti i kompajler ih vektorizuje. Racuna se u
+// double, jer su polovi za veliko sigma blizu 1 pa float akumulira gresku od nekoliko nivoa.
+// Ivice prema --border=zero|replicate|reflect101|wrap: signal se prosiruje za ceil(4 sigma) uzoraka sa svake
+// strane, a stanje filtra na pocetku prosirenja je stacionarno stanje prvog uzorka.
+// test() poredi rezultat sa direktnom separabilnom konvolucijom uzorkovanim Gausovim kernelom radijusa 4 sigma.
+class Convolution_RecursiveGaussian
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat inputImage;
+    Mat outputBuffer;
+    BorderMode borderMode;
+    double sigma;
+    int padding;
+    RecursiveGaussianCoefficients coefficients;
+    Mat horizontalPass;
+    Mat outputImage;
+
+    void filterRows(bool parallel);
+    void filterColumns(bool parallel);
+    Mat convolve(bool parallel);
+    Mat directGaussian(bool parallel);
+
+public:
+    Convolution_RecursiveGaussian(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
@@ -0,0 +1,164 @@
+#include "Convolution_Separable.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+Convolution_Separable::Convolution_Separable(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Separable::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	tolerance = arguments.getDoubleOption("tolerance", 0.0);
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+
+	KernelDecomposition decomposition(convolutionKernel, tolerance);
+	kernelTerms = decomposition.getTerms();
+
+	// Dva 1-D prolaza po clanu isplate se samo dok je 2K * rang manje od K^2
+	int rank = decomposition.getRank();
+	useSeparablePasses = 2 * convolutionKernel.rows * rank < convolutionKernel.rows * convolutionKernel.cols;
+
+	kernelDescription = "rang " + to_string(rank) + " od " + to_string(decomposition.getFullRank());
+	kernelDescription += ", relativna greska " + to_string(decomposition.getRelativeError());
+	kernelDescription += ", max greska piksela " + to_string(decomposition.getMaxOutputError());
+	if (!useSeparablePasses) {
+		kernelDescription += ", direktna konvolucija";
+	}
+}
+
+void Convolution_Separable::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Separable::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_Separable::setOutputImage(Mat image)
+{
+	outputBuffer = image;
+}
+
+void Convolution_Separable::separableConvolution(Mat& resultImage, bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	int half = convolutionKernel.rows / 2;
+
+	resultImage = Mat(rows, cols, CV_64FC3, Scalar(0, 0, 0));
+	Mat horizontalPass(rows, cols, CV_64FC3);
+
+	// Indeksi van slike preslikani jednom; sourceCols[y + v + half] je izvorna kolona za tap v
+	vector<int> sourceRows(rows + 2 * half);
+	vector<int> sourceCols(cols + 2 * half);
+	for (int i = 0; i < (int)sourceRows.size(); i++) {
+		sourceRows[i] = mapBorderIndex(i - half, rows, borderMode);
+	}
+	for (int j = 0; j < (int)sourceCols.size(); j++) {
+		sourceCols[j] = mapBorderIndex(j - half, cols, borderMode);
+	}
+
+	for (size_t t = 0; t < kernelTerms.size(); t++) {
+		const double* rowTaps = kernelTerms[t].row.ptr<double>(0);
+		vector<double> columnTaps(kernelTerms[t].column.rows);
+		for (int i = 0; i < kernelTerms[t].column.rows; i++) {
+			columnTaps[i] = kernelTerms[t].column.at<double>(i);
+		}
+
+		// Horizontalni prolaz: svaki red sa vektorom row (pikseli van slike prema nacinu prosirenja)
+		forEachIndex(rows, parallel, [&](int x) {
+			const double* source = inputImage.ptr<double>(x);
+			double* destination = horizontalPass.ptr<double>(x);
+			for (int y = 0; y < cols; y++) {
+				double r = 0, g = 0, b = 0;
+				for (int v = -half; v <= half; v++) {
+					int sourceCol = sourceCols[y + v + half];
+					if (sourceCol < 0) {
+						continue;
+					}
+					double weight = rowTaps[v + half];
+					const double* pixel = source + 3 * sourceCol;
+					r += pixel[0] * weight;
+					g += pixel[1] * weight;
+					b += pixel[2] * weight;
+				}
+				destination[3 * y] = r;
+				destination[3 * y + 1] = g;
+				destination[3 * y + 2] = b;
+			}
+		});
+
+		// Vertikalni prolaz: cijeli redovi se sabiraju sa tezinom iz vektora column i dodaju rezultatu
+		forEachIndex(rows, parallel, [&](int x) {
+			double* destination = resultImage.ptr<double>(x);
+			for (int u = -half; u <= half; u++) {
+				int sourceRow = sourceRows[x + u + half];
+				if (sourceRow < 0) {
+					continue;
+				}
+				double weight = columnTaps[u + half];
+				const double* source = horizontalPass.ptr<double>(sourceRow);
+				for (int i = 0; i < 3 * cols; i++) {
+					destination[i] += source[i] * weight;
+				}
+			}
+		});
+	}
+}
+
+Mat Convolution_Separable::performConvolution()
+{
+	inputImage.convertTo(inputImage, CV_64FC3);
+
+	Mat resultImage;
+	if (useSeparablePasses) {
+		separableConvolution(resultImage, false);
+	}
+	else {
+		convolveDirect(inputImage, convolutionKernel, borderMode, resultImage, false);
+	}
+	Mat outputImage = outputBuffer;
+	resultImage.convertTo(outputImage, CV_8UC3);
+	return outputImage;
+}
+
+Mat Convolution_Separable::performParallelConvolution()
+{
+	inputImage.convertTo(inputImage, CV_64FC3);
+
+	Mat resultImage;
+	if (useSeparablePasses) {
+		separableConvolution(resultImage, true);
+	}
+	else {
+		convolveDirect(inputImage, convolutionKernel, borderMode, resultImage, true);
+	}
+	Mat outputImage = outputBuffer;
+	resultImage.convertTo(outputImage, CV_8UC3);
+	return outputImage;
+}
+
+String Convolution_Separable::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nSeparabilni kernel (" + kernelDescription + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nSeparabilni kernel (" + kernelDescription + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	return log;
+}
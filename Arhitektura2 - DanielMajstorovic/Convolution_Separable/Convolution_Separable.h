@@ -0,0 +1,40 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "KernelDecomposition.h"
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija separabilnim kernelom: K x K kernel se rastavlja na sumu clanova column * row,
+// pa se svaki clan racuna kao dva 1-D prolaza (2K umjesto K^2 mnozenja po pikselu i clanu).
+// Tolerancija aproksimacije zadaje se opcijom --tolerance=x (podrazumijevano 0, tj. tacno rastavljanje).
+// Prosirenje prema --border je isto u oba prolaza, jer se red i kolona preslikavaju nezavisno.
+class Convolution_Separable
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    Mat outputBuffer;
+    double tolerance;
+    BorderMode borderMode;
+    vector<SeparableTerm> kernelTerms;
+    bool useSeparablePasses;
+    String kernelDescription;
+
+    void separableConvolution(Mat& resultImage, bool parallel);
+
+public:
+    Convolution_Separable(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    // Rezultat se upisuje u zadati bafer kada ima oblik ulaza (CV_8UC3), inace u novi
+    void setOutputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
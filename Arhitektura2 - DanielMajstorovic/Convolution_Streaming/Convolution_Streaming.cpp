@@ -0,0 +1,203 @@
+#include "Convolution_Streaming.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cstring>
+
+Convolution_Streaming::Convolution_Streaming(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Streaming::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	convolutionKernel = arguments.getKernel();
+	int memoryMegabytes = arguments.getIntOption("memory", 256);
+	if (memoryMegabytes <= 0) {
+		throw invalid_argument("Opcija --memory mora biti pozitivan broj megabajta");
+	}
+	memoryBudget = (size_t)memoryMegabytes * 1024 * 1024;
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	if (borderMode == BorderWrap) {
+		throw invalid_argument("Obrada u pojasevima ne podrzava --border=wrap (prvi pojas bi trazio posljednje redove slike)");
+	}
+
+	kernelTaps.resize(convolutionKernel.rows * convolutionKernel.cols);
+	for (int u = 0; u < convolutionKernel.rows; u++) {
+		for (int v = 0; v < convolutionKernel.cols; v++) {
+			kernelTaps[u * convolutionKernel.cols + v] = convolutionKernel.at<double>(u, v);
+		}
+	}
+
+	// Slika se ne ucitava ovdje, cita se samo zaglavlje zbog dimenzija
+	ImageBandReader reader(inputFilePath);
+	imageRows = reader.getRows();
+	imageCols = reader.getCols();
+	streamedInput = reader.isStreamed();
+	bandRows = chooseBandRows(imageCols);
+}
+
+int Convolution_Streaming::chooseBandRows(int cols)
+{
+	int halo = 2 * (convolutionKernel.rows / 2);
+	size_t windowRowBytes = (size_t)(cols + halo) * 3 * sizeof(double);
+	// Po redu pojasa: red prozora (double), ulazni i izlazni red u 8 bita
+	size_t bandRowBytes = windowRowBytes + 2 * (size_t)cols * 3;
+	size_t haloBytes = halo * windowRowBytes;
+
+	if (memoryBudget < haloBytes + bandRowBytes) {
+		throw invalid_argument("Opcija --memory je premala za sirinu slike i velicinu kernela");
+	}
+	size_t rows = (memoryBudget - haloBytes) / bandRowBytes;
+	return (int)min(rows, (size_t)max(imageRows, 1));
+}
+
+void Convolution_Streaming::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Streaming::convolveRow(const Mat& window, int windowRow, uchar* destination)
+{
+	int kernelSize = convolutionKernel.rows;
+	const double* taps = kernelTaps.data();
+
+	for (int y = 0; y < imageCols; y++) {
+		double b = 0, g = 0, r = 0;
+		for (int u = 0; u < kernelSize; u++) {
+			const double* source = window.ptr<double>(windowRow + u) + 3 * y;
+			const double* coefficients = taps + u * kernelSize;
+			for (int v = 0; v < kernelSize; v++) {
+				b += source[3 * v] * coefficients[v];
+				g += source[3 * v + 1] * coefficients[v];
+				r += source[3 * v + 2] * coefficients[v];
+			}
+		}
+		destination[3 * y] = saturate_cast<uchar>(b);
+		destination[3 * y + 1] = saturate_cast<uchar>(g);
+		destination[3 * y + 2] = saturate_cast<uchar>(r);
+	}
+}
+
+void Convolution_Streaming::convolveStream(ImageBandReader& reader, const function<void(const Mat&)>& writeBand, bool parallel)
+{
+	int half = convolutionKernel.rows / 2;
+	int rows = reader.getRows();
+	int cols = reader.getCols();
+
+	// Red i prozora odgovara redu slike (top - half + i); redovi i kolone izvan slike prema nacinu prosirenja
+	Mat window(bandRows + 2 * half, cols + 2 * half, CV_64FC3, Scalar(0, 0, 0));
+	Mat inputBand;
+	Mat outputBand(bandRows, cols, CV_8UC3);
+	size_t windowRowBytes = window.cols * window.elemSize();
+	vector<int> sourceCols(cols + 2 * half);
+	for (int j = 0; j < (int)sourceCols.size(); j++) {
+		sourceCols[j] = mapBorderIndex(j - half, cols, borderMode);
+	}
+
+	int loadedRows = half;
+	int nextInputRow = 0;
+	for (int top = 0; top < rows; top += bandRows) {
+		int count = min(bandRows, rows - top);
+		int neededRows = count + 2 * half;
+		int readCount = min(neededRows - loadedRows, rows - nextInputRow);
+
+		reader.readRows(readCount, inputBand);
+		nextInputRow += readCount;
+		forEachIndex(readCount, parallel, [&](int i) {
+			const uchar* source = inputBand.ptr<uchar>(i);
+			double* destination = window.ptr<double>(loadedRows + i);
+			for (int j = 0; j < (int)sourceCols.size(); j++) {
+				for (int c = 0; c < 3; c++) {
+					destination[3 * j + c] = sourceCols[j] < 0 ? 0.0 : source[3 * sourceCols[j] + c];
+				}
+			}
+		});
+		// Iznad prvog i ispod posljednjeg reda slike: preslikani red je vec u prozoru
+		for (int i = 0; i < neededRows; i++) {
+			int x = top - half + i;
+			if (x >= 0 && x < rows) {
+				continue;
+			}
+			int sourceRow = mapBorderIndex(x, rows, borderMode);
+			if (sourceRow < 0) {
+				memset(window.ptr<double>(i), 0, windowRowBytes);
+			}
+			else {
+				memcpy(window.ptr<double>(i), window.ptr<double>(sourceRow - (top - half)), windowRowBytes);
+			}
+		}
+
+		forEachIndex(count, parallel, [&](int x) {
+			convolveRow(window, x, outputBand.ptr<uchar>(x));
+		});
+		writeBand(outputBand.rowRange(0, count));
+
+		// Oreol za sljedeci pojas: izvor je uvijek ispod odredista, pa kopiranje redom ne gazi podatke
+		for (int i = 0; i < 2 * half; i++) {
+			memcpy(window.ptr<double>(i), window.ptr<double>(count + i), windowRowBytes);
+		}
+		loadedRows = 2 * half;
+	}
+}
+
+void Convolution_Streaming::performStreamingConvolution(bool parallel)
+{
+	ImageBandReader reader(inputFilePath);
+	ImageBandWriter writer(outputFilePath, reader.getRows(), reader.getCols());
+	convolveStream(reader, [&writer](const Mat& band) { writer.writeRows(band); }, parallel);
+	writer.close();
+}
+
+Mat Convolution_Streaming::performConvolution()
+{
+	ImageBandReader reader(inputFilePath);
+	Mat resultImage(reader.getRows(), reader.getCols(), CV_8UC3);
+	int writtenRows = 0;
+	convolveStream(reader, [&](const Mat& band) {
+		band.copyTo(resultImage.rowRange(writtenRows, writtenRows + band.rows));
+		writtenRows += band.rows;
+	}, false);
+	return resultImage;
+}
+
+Mat Convolution_Streaming::performParallelConvolution()
+{
+	ImageBandReader reader(inputFilePath);
+	Mat resultImage(reader.getRows(), reader.getCols(), CV_8UC3);
+	int writtenRows = 0;
+	convolveStream(reader, [&](const Mat& band) {
+		band.copyTo(resultImage.rowRange(writtenRows, writtenRows + band.rows));
+		writtenRows += band.rows;
+	}, true);
+	return resultImage;
+}
+
+String Convolution_Streaming::getStreamingReport()
+{
+	int halo = 2 * (convolutionKernel.rows / 2);
+	size_t workingBytes = (size_t)(bandRows + halo) * (imageCols + halo) * 3 * sizeof(double) + 2 * (size_t)bandRows * imageCols * 3;
+	String report = "pojas od " + to_string(bandRows) + " redova, radna memorija " + to_string(workingBytes / 1024) + " KB";
+	if (!streamedInput) {
+		report += ", ulaz dekodiran cijeli";
+	}
+	return report;
+}
+
+String Convolution_Streaming::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(imageCols) + " x " + to_string(imageRows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nTok u pojasevima (" + getStreamingReport() + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nTok u pojasevima (" + getStreamingReport() + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	return log;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include <functional>
+#include "ImageBandStream.h"
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija slika vecih od radne memorije. Ulaz se cita u horizontalnim pojasevima, svaki pojas
+// se pretvara u double u prozor prosiren prema --border (pojas + K - 1 redova oreola), a nakon racunanja se
+// posljednjih K - 1 redova prozora pomjera na njegov pocetak za sljedeci pojas (kotrljajuci bafer).
+// Izlaz se upisuje pojas po pojas, pa je zauzeta memorija ogranicena opcijom --memory=MB
+// (podrazumijevano 256) bez obzira na velicinu slike. PPM i nekompresovani BMP se citaju i pisu
+// direktno iz fajla; ostali formati se dekodiraju/kodiraju cijeli u 8 bita (3 bajta po pikselu).
+// Opcija --stream u glavnom programu pokrece samo ovaj nacin rada sa izlazom u zadati fajl.
+// Redovi van slike za replicate i reflect101 su kopije redova koji su vec u prozoru; wrap bi za prvi
+// pojas trazio posljednje redove slike, pa ga ovaj nacin rada ne podrzava.
+class Convolution_Streaming
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    vector<double> kernelTaps;
+    size_t memoryBudget;
+    int imageRows;
+    int imageCols;
+    bool streamedInput;
+    int bandRows;
+    BorderMode borderMode;
+
+    int chooseBandRows(int cols);
+    void convolveRow(const Mat& window, int windowRow, uchar* destination);
+    void convolveStream(ImageBandReader& reader, const function<void(const Mat&)>& writeBand, bool parallel);
+
+public:
+    Convolution_Streaming(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    // Cita ulazni fajl i upisuje rezultat u izlazni fajl pojas po pojas
+    void performStreamingConvolution(bool parallel);
+    String getStreamingReport();
+    String test();
+};
@@ -0,0 +1,318 @@
+#include "ImageBandStream.h"
+#include <stdexcept>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+
+static FILE* openFile(const String& path, const char* mode)
+{
+#ifdef _WIN32
+	FILE* file = nullptr;
+	return fopen_s(&file, path.c_str(), mode) == 0 ? file : nullptr;
+#else
+	return fopen(path.c_str(), mode);
+#endif
+}
+
+// Pozicioniranje u fajlovima vecim od 2 GB
+static int seekFile(FILE* file, long long offset)
+{
+#ifdef _WIN32
+	return _fseeki64(file, offset, SEEK_SET);
+#else
+	return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+static long long tellFile(FILE* file)
+{
+#ifdef _WIN32
+	return _ftelli64(file);
+#else
+	return (long long)ftello(file);
+#endif
+}
+
+static unsigned int readLittleEndian(const uchar* bytes, int count)
+{
+	unsigned int value = 0;
+	for (int i = count - 1; i >= 0; i--) {
+		value = (value << 8) | bytes[i];
+	}
+	return value;
+}
+
+static void writeLittleEndian(uchar* bytes, unsigned int value, int count)
+{
+	for (int i = 0; i < count; i++) {
+		bytes[i] = (uchar)(value >> (8 * i));
+	}
+}
+
+// Sljedeci broj iz PPM zaglavlja, uz preskakanje razmaka i komentara
+static bool readPpmNumber(FILE* file, int& value)
+{
+	int character = fgetc(file);
+	while (character != EOF && (isspace(character) || character == '#')) {
+		if (character == '#') {
+			while (character != EOF && character != '\n') {
+				character = fgetc(file);
+			}
+		}
+		character = fgetc(file);
+	}
+	if (character == EOF || !isdigit(character)) {
+		return false;
+	}
+	value = 0;
+	while (character != EOF && isdigit(character)) {
+		value = value * 10 + (character - '0');
+		character = fgetc(file);
+	}
+	// Tacno jedan razmak razdvaja maxval od podataka, pa se znak nakon broja ne vraca
+	return true;
+}
+
+static ImageStreamFormat formatFromExtension(const String& path)
+{
+	size_t dotPosition = path.find_last_of('.');
+	String extension = dotPosition == String::npos ? "" : path.substr(dotPosition + 1);
+	transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+	if (extension == "ppm" || extension == "pnm") {
+		return StreamPpm;
+	}
+	if (extension == "bmp") {
+		return StreamBmp;
+	}
+	return StreamEncoded;
+}
+
+ImageBandReader::ImageBandReader(const String& path)
+{
+	file = openFile(path, "rb");
+	format = StreamEncoded;
+	rows = cols = 0;
+	dataOffset = rowStride = 0;
+	bytesPerPixel = 3;
+	bottomUp = false;
+	nextRow = 0;
+
+	if (file != nullptr && (openPpm() || openBmp())) {
+		rowBuffer.resize((size_t)rowStride);
+		return;
+	}
+
+	if (file != nullptr) {
+		fclose(file);
+		file = nullptr;
+	}
+	decodedImage = imread(path);
+	if (decodedImage.empty()) {
+		throw invalid_argument("Slika " + path + " se ne moze ucitati");
+	}
+	rows = decodedImage.rows;
+	cols = decodedImage.cols;
+}
+
+bool ImageBandReader::openPpm()
+{
+	seekFile(file, 0);
+	char magic[2];
+	int maxValue = 0;
+	if (fread(magic, 1, 2, file) != 2 || magic[0] != 'P' || magic[1] != '6') {
+		return false;
+	}
+	// 16-bitni PPM (maxval > 255) ide kroz imread
+	if (!readPpmNumber(file, cols) || !readPpmNumber(file, rows) || !readPpmNumber(file, maxValue) || maxValue > 255) {
+		return false;
+	}
+	format = StreamPpm;
+	dataOffset = tellFile(file);
+	rowStride = 3LL * cols;
+	bytesPerPixel = 3;
+	return true;
+}
+
+bool ImageBandReader::openBmp()
+{
+	seekFile(file, 0);
+	uchar header[54];
+	if (fread(header, 1, sizeof(header), file) != sizeof(header) || header[0] != 'B' || header[1] != 'M') {
+		return false;
+	}
+	int bitCount = (int)readLittleEndian(header + 28, 2);
+	unsigned int compression = readLittleEndian(header + 30, 4);
+	// Samo nekompresovani BGR/BGRA; palete i kompresija idu kroz imread
+	if ((bitCount != 24 && bitCount != 32) || compression != 0) {
+		return false;
+	}
+	int height = (int)readLittleEndian(header + 22, 4);
+	format = StreamBmp;
+	dataOffset = readLittleEndian(header + 10, 4);
+	cols = (int)readLittleEndian(header + 18, 4);
+	rows = abs(height);
+	bottomUp = height > 0;
+	bytesPerPixel = bitCount / 8;
+	rowStride = ((long long)cols * bytesPerPixel + 3) & ~3LL;
+	return true;
+}
+
+ImageBandReader::~ImageBandReader()
+{
+	if (file != nullptr) {
+		fclose(file);
+	}
+}
+
+int ImageBandReader::getRows()
+{
+	return rows;
+}
+
+int ImageBandReader::getCols()
+{
+	return cols;
+}
+
+bool ImageBandReader::isStreamed()
+{
+	return format != StreamEncoded;
+}
+
+void ImageBandReader::readRows(int count, Mat& band)
+{
+	if (count < 0 || nextRow + count > rows) {
+		throw invalid_argument("Citanje izvan granica slike");
+	}
+	band.create(count, cols, CV_8UC3);
+
+	if (format == StreamEncoded) {
+		decodedImage.rowRange(nextRow, nextRow + count).copyTo(band);
+		nextRow += count;
+		return;
+	}
+
+	for (int i = 0; i < count; i++, nextRow++) {
+		uchar* destination = band.ptr<uchar>(i);
+		if (format == StreamBmp) {
+			int fileRow = bottomUp ? rows - 1 - nextRow : nextRow;
+			seekFile(file, dataOffset + fileRow * rowStride);
+		}
+		if (fread(rowBuffer.data(), 1, (size_t)rowStride, file) != (size_t)rowStride) {
+			throw invalid_argument("Neocekivan kraj fajla slike");
+		}
+		if (format == StreamPpm) {
+			// PPM je RGB, OpenCV BGR
+			for (int y = 0; y < cols; y++) {
+				destination[3 * y] = rowBuffer[3 * y + 2];
+				destination[3 * y + 1] = rowBuffer[3 * y + 1];
+				destination[3 * y + 2] = rowBuffer[3 * y];
+			}
+		}
+		else {
+			for (int y = 0; y < cols; y++) {
+				destination[3 * y] = rowBuffer[bytesPerPixel * y];
+				destination[3 * y + 1] = rowBuffer[bytesPerPixel * y + 1];
+				destination[3 * y + 2] = rowBuffer[bytesPerPixel * y + 2];
+			}
+		}
+	}
+}
+
+ImageBandWriter::ImageBandWriter(const String& path, int rows, int cols)
+	: file(nullptr), format(formatFromExtension(path)), path(path), rows(rows), cols(cols), dataOffset(0), rowStride(0), nextRow(0)
+{
+	if (format == StreamEncoded) {
+		encodedImage.create(rows, cols, CV_8UC3);
+		return;
+	}
+
+	file = openFile(path, "wb");
+	if (file == nullptr) {
+		throw invalid_argument("Fajl " + path + " se ne moze otvoriti za pisanje");
+	}
+
+	if (format == StreamPpm) {
+		fprintf(file, "P6\n%d %d\n255\n", cols, rows);
+		dataOffset = tellFile(file);
+		rowStride = 3LL * cols;
+	}
+	else {
+		// BMP sa pozitivnom visinom (redovi odozdo nagore), jer ga citaju svi pregledaci
+		rowStride = (3LL * cols + 3) & ~3LL;
+		dataOffset = 54;
+		uchar header[54] = { 0 };
+		header[0] = 'B';
+		header[1] = 'M';
+		writeLittleEndian(header + 2, (unsigned int)(dataOffset + rowStride * rows), 4);
+		writeLittleEndian(header + 10, (unsigned int)dataOffset, 4);
+		writeLittleEndian(header + 14, 40, 4);
+		writeLittleEndian(header + 18, (unsigned int)cols, 4);
+		writeLittleEndian(header + 22, (unsigned int)rows, 4);
+		writeLittleEndian(header + 26, 1, 2);
+		writeLittleEndian(header + 28, 24, 2);
+		writeLittleEndian(header + 34, (unsigned int)(rowStride * rows), 4);
+		fwrite(header, 1, sizeof(header), file);
+	}
+	rowBuffer.assign((size_t)rowStride, 0);
+}
+
+ImageBandWriter::~ImageBandWriter()
+{
+	try {
+		close();
+	}
+	catch (...) {
+	}
+}
+
+bool ImageBandWriter::isStreamed()
+{
+	return format != StreamEncoded;
+}
+
+void ImageBandWriter::writeRows(const Mat& band)
+{
+	if (band.cols != cols || band.type() != CV_8UC3 || nextRow + band.rows > rows) {
+		throw invalid_argument("Pojas ne odgovara dimenzijama izlazne slike");
+	}
+
+	if (format == StreamEncoded) {
+		band.copyTo(encodedImage.rowRange(nextRow, nextRow + band.rows));
+		nextRow += band.rows;
+		return;
+	}
+
+	for (int i = 0; i < band.rows; i++, nextRow++) {
+		const uchar* source = band.ptr<uchar>(i);
+		if (format == StreamPpm) {
+			for (int y = 0; y < cols; y++) {
+				rowBuffer[3 * y] = source[3 * y + 2];
+				rowBuffer[3 * y + 1] = source[3 * y + 1];
+				rowBuffer[3 * y + 2] = source[3 * y];
+			}
+		}
+		else {
+			memcpy(rowBuffer.data(), source, 3 * (size_t)cols);
+			seekFile(file, dataOffset + (rows - 1 - nextRow) * rowStride);
+		}
+		if (fwrite(rowBuffer.data(), 1, (size_t)rowStride, file) != (size_t)rowStride) {
+			throw invalid_argument("Greska pri pisanju fajla " + path);
+		}
+	}
+}
+
+void ImageBandWriter::close()
+{
+	if (format == StreamEncoded) {
+		if (!encodedImage.empty()) {
+			imwrite(path, encodedImage);
+			encodedImage.release();
+		}
+		return;
+	}
+	if (file != nullptr) {
+		fclose(file);
+		file = nullptr;
+	}
+}
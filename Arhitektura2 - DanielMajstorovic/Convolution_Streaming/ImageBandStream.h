@@ -0,0 +1,72 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <vector>
+
+using namespace cv;
+using namespace std;
+
+// Nacin na koji se slika cita/pise: binarni PPM (P6) i nekompresovani BMP (24/32 bita) se obradjuju
+// red po red direktno iz fajla; ostali formati (JPEG, PNG, ...) nemaju takav pristup kroz OpenCV,
+// pa se dekodiraju/kodiraju cijeli u 8 bita.
+enum ImageStreamFormat
+{
+    StreamPpm,
+    StreamBmp,
+    StreamEncoded
+};
+
+// Sekvencijalno citanje slike u horizontalnim pojasevima CV_8UC3
+class ImageBandReader
+{
+    FILE* file;
+    ImageStreamFormat format;
+    Mat decodedImage;
+    int rows;
+    int cols;
+    long long dataOffset;
+    long long rowStride;
+    int bytesPerPixel;
+    bool bottomUp;
+    int nextRow;
+    vector<uchar> rowBuffer;
+
+    bool openPpm();
+    bool openBmp();
+
+public:
+    ImageBandReader(const String& path);
+    ~ImageBandReader();
+    ImageBandReader(const ImageBandReader&) = delete;
+    ImageBandReader& operator=(const ImageBandReader&) = delete;
+    int getRows();
+    int getCols();
+    bool isStreamed();
+    // Ucitava sljedecih count redova slike u band (count x cols, CV_8UC3)
+    void readRows(int count, Mat& band);
+};
+
+// Sekvencijalno pisanje slike u horizontalnim pojasevima CV_8UC3; format se bira po ekstenziji
+class ImageBandWriter
+{
+    FILE* file;
+    ImageStreamFormat format;
+    String path;
+    Mat encodedImage;
+    int rows;
+    int cols;
+    long long dataOffset;
+    long long rowStride;
+    int nextRow;
+    vector<uchar> rowBuffer;
+
+public:
+    ImageBandWriter(const String& path, int rows, int cols);
+    ~ImageBandWriter();
+    ImageBandWriter(const ImageBandWriter&) = delete;
+    ImageBandWriter& operator=(const ImageBandWriter&) = delete;
+    bool isStreamed();
+    // Upisuje sljedece band.rows redove slike
+    void writeRows(const Mat& band);
+    void close();
+};
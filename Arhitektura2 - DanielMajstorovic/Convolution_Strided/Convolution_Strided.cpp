@@ -0,0 +1,245 @@
+#include "Convolution_Strided.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <cmath>
+
+// 5x5 binomni kernel (1 4 6 4 1)^T (1 4 6 4 1) / 256 za piramide
+static Mat binomialKernel()
+{
+	double taps[5] = { 1, 4, 6, 4, 1 };
+	Mat kernel(5, 5, CV_64F);
+	for (int u = 0; u < 5; u++) {
+		for (int v = 0; v < 5; v++) {
+			kernel.at<double>(u, v) = taps[u] * taps[v] / 256;
+		}
+	}
+	return kernel;
+}
+
+// Svaki step-ti piksel slike, pocevsi od (0, 0)
+static Mat decimate(const Mat& image, int step)
+{
+	Mat result((image.rows + step - 1) / step, (image.cols + step - 1) / step, image.type());
+	for (int i = 0; i < result.rows; i++) {
+		for (int j = 0; j < result.cols; j++) {
+			result.at<Vec3b>(i, j) = image.at<Vec3b>(i * step, j * step);
+		}
+	}
+	return result;
+}
+
+Convolution_Strided::Convolution_Strided(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Strided::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	stride = arguments.getIntOption("stride", 1);
+	dilation = arguments.getIntOption("dilation", 1);
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+
+	if (stride < 1 || dilation < 1) {
+		throw invalid_argument("Opcije --stride i --dilation moraju biti bar 1");
+	}
+}
+
+void Convolution_Strided::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Strided::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+Mat Convolution_Strided::convolve(const Mat& image, const Mat& kernel, int step, int spacing, BorderMode mode, bool parallel)
+{
+	if (image.type() != CV_8UC3) {
+		throw invalid_argument("Ulazna slika mora biti CV_8UC3");
+	}
+
+	int kernelRowsSizeHalf = kernel.rows / 2;
+	int kernelColsSizeHalf = kernel.cols / 2;
+	int outputRows = (image.rows + step - 1) / step;
+	int outputCols = (image.cols + step - 1) / step;
+	Mat resultImage(outputRows, outputCols, CV_8UC3);
+
+	// Izlazne kolone ciji svi tapovi leze u slici citaju izvor direktno; ostale idu preko tabele
+	int reach = kernelColsSizeHalf * spacing;
+	int firstInterior = min(outputCols, (reach + step - 1) / step);
+	int lastInterior = image.cols - 1 - reach >= 0 ? min(outputCols, (image.cols - 1 - reach) / step + 1) : 0;
+	lastInterior = max(lastInterior, firstInterior);
+
+	vector<int> colTable((size_t)outputCols * kernel.cols);
+	for (int j = 0; j < outputCols; j++) {
+		for (int v = 0; v < kernel.cols; v++) {
+			colTable[(size_t)j * kernel.cols + v] = mapBorderIndex(j * step + (v - kernelColsSizeHalf) * spacing, image.cols, mode);
+		}
+	}
+
+	forEachIndex(outputRows, parallel, [&](int i) {
+		// Akumulator jednog izlaznog reda; tapovi se za svaki piksel sabiraju redom (u, v), kao u direktnoj petlji
+		thread_local vector<double> accumulator;
+		accumulator.assign(3 * (size_t)outputCols, 0.0);
+
+		for (int u = 0; u < kernel.rows; u++) {
+			int sourceRow = mapBorderIndex(i * step + (u - kernelRowsSizeHalf) * spacing, image.rows, mode);
+			if (sourceRow < 0) {
+				continue;
+			}
+			const uchar* row = image.ptr<uchar>(sourceRow);
+			const double* taps = kernel.ptr<double>(u);
+
+			for (int v = 0; v < kernel.cols; v++) {
+				double weight = taps[v];
+				int offset = (v - kernelColsSizeHalf) * spacing;
+
+				for (int j = 0; j < firstInterior; j++) {
+					int sourceCol = colTable[(size_t)j * kernel.cols + v];
+					if (sourceCol >= 0) {
+						const uchar* pixel = row + 3 * sourceCol;
+						accumulator[3 * j] += pixel[0] * weight;
+						accumulator[3 * j + 1] += pixel[1] * weight;
+						accumulator[3 * j + 2] += pixel[2] * weight;
+					}
+				}
+				for (int j = firstInterior; j < lastInterior; j++) {
+					const uchar* pixel = row + 3 * (j * step + offset);
+					accumulator[3 * j] += pixel[0] * weight;
+					accumulator[3 * j + 1] += pixel[1] * weight;
+					accumulator[3 * j + 2] += pixel[2] * weight;
+				}
+				for (int j = lastInterior; j < outputCols; j++) {
+					int sourceCol = colTable[(size_t)j * kernel.cols + v];
+					if (sourceCol >= 0) {
+						const uchar* pixel = row + 3 * sourceCol;
+						accumulator[3 * j] += pixel[0] * weight;
+						accumulator[3 * j + 1] += pixel[1] * weight;
+						accumulator[3 * j + 2] += pixel[2] * weight;
+					}
+				}
+			}
+		}
+
+		uchar* destination = resultImage.ptr<uchar>(i);
+		for (int k = 0; k < 3 * outputCols; k++) {
+			destination[k] = saturate_cast<uchar>(accumulator[k]);
+		}
+	});
+	return resultImage;
+}
+
+Mat Convolution_Strided::upsample(const Mat& image, Size size, bool parallel)
+{
+	// Povecanje 2x umetanjem nula i binomnim kernelom x 4, ali bez umetnutih nula: za svaki izlazni
+	// red (kolonu) racunaju se samo tapovi iste parnosti, koji padaju na postojece uzorke (3 ili 2 od 5)
+	Mat kernel = binomialKernel();
+	Mat resultImage(size, CV_8UC3);
+
+	vector<int> colTaps, colSources;
+	vector<int> colBegin(size.width + 1, 0);
+	for (int x = 0; x < size.width; x++) {
+		for (int v = x % 2 == 0 ? 0 : 1; v < 5; v += 2) {
+			colTaps.push_back(v);
+			colSources.push_back(mapBorderIndex((x + v - 2) / 2, image.cols, BorderReflect101));
+		}
+		colBegin[x + 1] = (int)colTaps.size();
+	}
+
+	forEachIndex(size.height, parallel, [&](int y) {
+		uchar* destination = resultImage.ptr<uchar>(y);
+		for (int x = 0; x < size.width; x++) {
+			double r = 0, g = 0, b = 0;
+			for (int u = y % 2 == 0 ? 0 : 1; u < 5; u += 2) {
+				const uchar* row = image.ptr<uchar>(mapBorderIndex((y + u - 2) / 2, image.rows, BorderReflect101));
+				const double* taps = kernel.ptr<double>(u);
+				for (int t = colBegin[x]; t < colBegin[x + 1]; t++) {
+					double weight = 4 * taps[colTaps[t]];
+					const uchar* pixel = row + 3 * colSources[t];
+					r += pixel[0] * weight;
+					g += pixel[1] * weight;
+					b += pixel[2] * weight;
+				}
+			}
+			destination[3 * x] = saturate_cast<uchar>(r);
+			destination[3 * x + 1] = saturate_cast<uchar>(g);
+			destination[3 * x + 2] = saturate_cast<uchar>(b);
+		}
+	});
+	return resultImage;
+}
+
+Mat Convolution_Strided::performConvolution()
+{
+	return convolve(inputImage, convolutionKernel, stride, dilation, borderMode, false);
+}
+
+Mat Convolution_Strided::performParallelConvolution()
+{
+	return convolve(inputImage, convolutionKernel, stride, dilation, borderMode, true);
+}
+
+Mat Convolution_Strided::performDecimatedFullConvolution(bool parallel)
+{
+	return decimate(convolve(inputImage, convolutionKernel, 1, dilation, borderMode, parallel), stride);
+}
+
+vector<Mat> Convolution_Strided::buildGaussianPyramid(int levels, bool parallel)
+{
+	Mat kernel = binomialKernel();
+	vector<Mat> pyramid;
+	pyramid.push_back(inputImage);
+	while ((int)pyramid.size() < levels && pyramid.back().rows > 1 && pyramid.back().cols > 1) {
+		pyramid.push_back(convolve(pyramid.back(), kernel, 2, 1, BorderReflect101, parallel));
+	}
+	return pyramid;
+}
+
+vector<Mat> Convolution_Strided::buildLaplacianPyramid(int levels, bool parallel)
+{
+	vector<Mat> gaussian = buildGaussianPyramid(levels, parallel);
+	vector<Mat> pyramid;
+	for (size_t k = 0; k + 1 < gaussian.size(); k++) {
+		Mat expanded = upsample(gaussian[k + 1], gaussian[k].size(), parallel);
+		Mat difference(gaussian[k].size(), CV_16SC3);
+		for (int y = 0; y < difference.rows; y++) {
+			const uchar* fine = gaussian[k].ptr<uchar>(y);
+			const uchar* coarse = expanded.ptr<uchar>(y);
+			short* destination = difference.ptr<short>(y);
+			for (int i = 0; i < 3 * difference.cols; i++) {
+				destination[i] = (short)(fine[i] - coarse[i]);
+			}
+		}
+		pyramid.push_back(difference);
+	}
+	pyramid.push_back(gaussian.back());
+	return pyramid;
+}
+
+String Convolution_Strided::test()
+{
+	String description = "korak " + to_string(stride) + ", dilatacija " + to_string(dilation) + ", " + getBorderModeName(borderMode);
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	log += "\nKonvolucija sa korakom (" + description + "), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performConvolution(); });
+	log += "\nKonvolucija sa korakom (" + description + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performParallelConvolution(); });
+	log += "\nPuna konvolucija pa decimacija (" + description + "), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return performDecimatedFullConvolution(true); });
+	log += "\nGausova piramida (6 nivoa), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return buildGaussianPyramid(6, true).back(); });
+	return log;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+
+using namespace cv;
+using namespace std;
+
+// Konvolucija sa korakom (decimacijom) i razmakom tapova (dilatacijom). Kernel se racuna samo u
+// zadrzanim izlaznim pikselima (i * stride, j * stride), pa je za korak 2 posao cetvrtina pune
+// konvolucije umjesto pune konvolucije i odbacivanja 75% rezultata. Tap (u, v) cita piksel udaljen
+// dilation * (u - K/2, v - K/2) od centra (a trous talasici). Izlaz je ceil(rows / stride) x
+// ceil(cols / stride), a za stride = dilation = 1 rezultat je isti kao kod osnovnih varijanti.
+// Opcije: --stride=N, --dilation=D, --border=zero|replicate|reflect101|wrap.
+// Na istoj petlji se grade Gausova i Laplasova piramida (5x5 binomni kernel, korak 2, reflect101).
+class Convolution_Strided
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    int stride;
+    int dilation;
+    BorderMode borderMode;
+
+    Mat convolve(const Mat& image, const Mat& kernel, int step, int spacing, BorderMode mode, bool parallel);
+    Mat upsample(const Mat& image, Size size, bool parallel);
+
+public:
+    Convolution_Strided(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    // Puna konvolucija pa uzimanje svakog stride-tog piksela (dosadasnji nacin), radi poredjenja
+    Mat performDecimatedFullConvolution(bool parallel);
+    // levels nivoa ukljucujuci ulaznu sliku; gradnja staje ranije ako nivo spadne na jedan piksel
+    vector<Mat> buildGaussianPyramid(int levels, bool parallel);
+    // L_k = G_k - up(G_k+1) u CV_16SC3, a posljednji nivo je najmanji Gausov nivo (CV_8UC3);
+    // G_k = up(G_k+1) + L_k vraca ulaz bez gubitka
+    vector<Mat> buildLaplacianPyramid(int levels, bool parallel);
+    String test();
+};
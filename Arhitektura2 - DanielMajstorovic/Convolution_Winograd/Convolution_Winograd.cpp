@@ -0,0 +1,225 @@
+#include "Convolution_Winograd.h"
+#include "ConvolutionArguments.h"
+#include "ConvolutionTiming.h"
+#include "WorkStealingPool.h"
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+Convolution_Winograd::Convolution_Winograd(int argc, char* argv[])
+{
+	readArguments(argc, argv);
+}
+
+void Convolution_Winograd::readArguments(int argc, char* argv[])
+{
+	ConvolutionArguments arguments(argc, argv);
+	inputFilePath = arguments.getInputFilePath();
+	outputFilePath = arguments.getOutputFilePath();
+	inputImage = imread(inputFilePath);
+	convolutionKernel = arguments.getKernel();
+	borderMode = parseBorderMode(arguments.getOption("border", "zero"));
+	setTileSize(arguments.getIntOption("winograd", 4));
+
+	// --isa ima prednost nad promjenljivom CONV_ISA; vektorska verzija postoji samo za AVX2
+	isa = selectIsaLevel(arguments.getOption("isa", ""));
+}
+
+void Convolution_Winograd::saveImage(Mat image)
+{
+	imwrite(outputFilePath, image);
+}
+
+void Convolution_Winograd::setInputImage(Mat image)
+{
+	inputImage = image;
+}
+
+void Convolution_Winograd::setTileSize(int size)
+{
+	if (size != 2 && size != 4) {
+		throw invalid_argument("Opcija --winograd mora biti 2 ili 4");
+	}
+	tileSize = size;
+}
+
+void Convolution_Winograd::convolveDirectSpan(int x, int firstColumn, int lastColumn, uchar* destination)
+{
+	int kernelRowsSizeHalf = convolutionKernel.rows / 2;
+	int kernelColsSizeHalf = convolutionKernel.cols / 2;
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+
+	for (int y = firstColumn; y < lastColumn; y++) {
+		double sum[3] = { 0, 0, 0 };
+		for (int u = 0; u < convolutionKernel.rows; u++) {
+			int sourceRow = mapBorderIndex(x + u - kernelRowsSizeHalf, rows, borderMode);
+			if (sourceRow < 0) {
+				continue;
+			}
+			const uchar* row = inputImage.ptr<uchar>(sourceRow);
+			for (int v = 0; v < convolutionKernel.cols; v++) {
+				int sourceCol = mapBorderIndex(y + v - kernelColsSizeHalf, cols, borderMode);
+				if (sourceCol < 0) {
+					continue;
+				}
+				double weight = convolutionKernel.at<double>(u, v);
+				const uchar* pixel = row + 3 * sourceCol;
+				sum[0] += pixel[0] * weight;
+				sum[1] += pixel[1] * weight;
+				sum[2] += pixel[2] * weight;
+			}
+		}
+		destination[3 * y] = saturate_cast<uchar>(sum[0]);
+		destination[3 * y + 1] = saturate_cast<uchar>(sum[1]);
+		destination[3 * y + 2] = saturate_cast<uchar>(sum[2]);
+	}
+}
+
+void Convolution_Winograd::convolveTileRow(int tileRow, int tileSize, int tileCols, const float* transformedKernel, WinogradBandFunction bandFunction)
+{
+	int cols = inputImage.cols;
+	int bandRows = tileSize + 2;
+	int bandCols = tileCols * tileSize + 2;
+	int tiledCols = tileCols * tileSize;
+	// Plocice ovog reda pokrivaju izlazne redove firstRow .. firstRow + tileSize - 1 i kolone 1 .. tiledCols
+	int firstRow = 1 + tileRow * tileSize;
+
+	thread_local vector<float> band;
+	thread_local vector<float> result;
+	band.resize(bandRows * bandCols);
+	result.resize(tileSize * tiledCols);
+
+	for (int c = 0; c < 3; c++) {
+		// Kanal c pojasa kao float redovi; plocica t cita kolone t*m .. t*m + m + 1
+		for (int i = 0; i < bandRows; i++) {
+			const uchar* source = inputImage.ptr<uchar>(firstRow - 1 + i);
+			float* destination = band.data() + i * bandCols;
+			for (int y = 0; y < bandCols; y++) {
+				destination[y] = source[3 * y + c];
+			}
+		}
+
+		bandFunction(band.data(), bandCols, tileCols, transformedKernel, result.data(), tiledCols);
+
+		for (int i = 0; i < tileSize; i++) {
+			const float* source = result.data() + i * tiledCols;
+			uchar* destination = outputImage.ptr<uchar>(firstRow + i) + 3 * 1 + c;
+			for (int y = 0; y < tiledCols; y++) {
+				destination[3 * y] = saturate_cast<uchar>(source[y]);
+			}
+		}
+	}
+
+	// Prva kolona i kolone desno od posljednje plocice
+	for (int i = 0; i < tileSize; i++) {
+		uchar* destination = outputImage.ptr<uchar>(firstRow + i);
+		convolveDirectSpan(firstRow + i, 0, 1, destination);
+		convolveDirectSpan(firstRow + i, 1 + tiledCols, cols, destination);
+	}
+}
+
+Mat Convolution_Winograd::convolve(int tileSize, bool parallel)
+{
+	int rows = inputImage.rows;
+	int cols = inputImage.cols;
+	outputImage.create(rows, cols, CV_8UC3);
+
+	// Plocice pokrivaju samo piksele ciji je cijeli prozor 3 x 3 u slici, pa ivicni nacin ne utice na njih
+	int tileRows = 0;
+	int tileCols = 0;
+	if (convolutionKernel.rows == 3 && convolutionKernel.cols == 3 && rows > 2 && cols > 2) {
+		tileRows = (rows - 2) / tileSize;
+		tileCols = (cols - 2) / tileSize;
+		if (tileCols == 0) {
+			tileRows = 0;
+		}
+	}
+
+	if (tileRows > 0) {
+		Mat kernel = convolutionKernel.isContinuous() ? convolutionKernel : convolutionKernel.clone();
+		float transformedKernel[36];
+		transformWinogradKernel(kernel.ptr<double>(), tileSize, transformedKernel);
+
+		WinogradBandFunction bandFunction;
+		if (isa >= IsaAvx2) {
+			bandFunction = tileSize == 2 ? winogradBandF2Avx2 : winogradBandF4Avx2;
+		}
+		else {
+			bandFunction = tileSize == 2 ? winogradBandF2Scalar : winogradBandF4Scalar;
+		}
+
+		forEachIndex(tileRows, parallel, [&](int tileRow) {
+			convolveTileRow(tileRow, tileSize, tileCols, transformedKernel, bandFunction);
+		});
+	}
+
+	// Ostali redovi direktno: prvi red i redovi ispod posljednjeg reda plocica, ili svi bez plocica
+	int firstDirectRow = tileRows > 0 ? 1 + tileRows * tileSize : 0;
+	int leadingRows = tileRows > 0 ? 1 : 0;
+	forEachIndex(leadingRows + rows - firstDirectRow, parallel, [&](int index) {
+		int x = index < leadingRows ? 0 : firstDirectRow + index - leadingRows;
+		convolveDirectSpan(x, 0, cols, outputImage.ptr<uchar>(x));
+	});
+
+	return outputImage;
+}
+
+Mat Convolution_Winograd::convolveDirect(bool parallel)
+{
+	outputImage.create(inputImage.rows, inputImage.cols, CV_8UC3);
+	forEachIndex(inputImage.rows, parallel, [&](int x) {
+		convolveDirectSpan(x, 0, inputImage.cols, outputImage.ptr<uchar>(x));
+	});
+	return outputImage;
+}
+
+Mat Convolution_Winograd::performConvolution()
+{
+	return convolve(tileSize, false);
+}
+
+Mat Convolution_Winograd::performParallelConvolution()
+{
+	return convolve(tileSize, true);
+}
+
+String Convolution_Winograd::test()
+{
+	String log = "Dimenzija slike: ";
+	log += to_string(inputImage.cols) + " x " + to_string(inputImage.rows);
+	log += "\nSlika na putanji: ";
+	log += inputFilePath;
+	if (convolutionKernel.rows != 3 || convolutionKernel.cols != 3) {
+		log += "\nKernel nije 3 x 3, Winograd varijanta racuna direktno";
+	}
+
+	log += "\nDirektna konvolucija (double), sekvencijalno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return convolveDirect(false); });
+	log += "\nDirektna konvolucija (double), paralelno izvrsavanje: ";
+	log += measureExecutionTime([this]() { return convolveDirect(true); });
+	Mat reference = convolveDirect(true).clone();
+
+	// Izabrana velicina plocice prva, pa druga radi poredjenja
+	const int tileSizes[] = { tileSize, tileSize == 2 ? 4 : 2 };
+	for (int size : tileSizes) {
+		String name = "Winograd F(" + to_string(size) + "x" + to_string(size) + ", 3x3) (" + getIsaLevelName(isa) + ")";
+		log += "\n" + name + ", sekvencijalno izvrsavanje: ";
+		log += measureExecutionTime([&]() { return convolve(size, false); });
+		log += "\n" + name + ", paralelno izvrsavanje: ";
+		log += measureExecutionTime([&]() { return convolve(size, true); });
+
+		Mat output = convolve(size, true);
+		int differentSamples = 0;
+		for (int x = 0; x < output.rows; x++) {
+			const uchar* outputRow = output.ptr<uchar>(x);
+			const uchar* referenceRow = reference.ptr<uchar>(x);
+			for (int i = 0; i < 3 * output.cols; i++) {
+				differentSamples += outputRow[i] != referenceRow[i];
+			}
+		}
+		log += " Najvece odstupanje od direktne: " + to_string((int)norm(output, reference, NORM_INF));
+		log += " nivoa, razlicitih vrijednosti: " + to_string(differentSamples);
+	}
+	return log;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/highgui.hpp>
+#include <omp.h>
+#include "BorderHandling.h"
+#include "CpuFeatures.h"
+#include "WinogradKernels.h"
+
+using namespace cv;
+using namespace std;
+
+// Brzi put za kernele 3 x 3: unutrasnjost slike se dijeli na plocice m x m (--winograd=2|4, podrazumijevano 4)
+// i svaka se racuna Winogradovim algoritmom F(m x m, 3 x 3) u float32, sa 4 (F2) ili 2.25 (F4) mnozenja po
+// izlaznom pikselu umjesto 9. Pojas od m + 2 reda svakog kanala prepisuje se u float red, pa AVX2 verzija
+// (--isa kao kod planarne varijante) obradjuje 8 susjednih plocica odjednom. Ivice slike, pikseli koji ne
+// popunjavaju cijelu plocicu i kerneli druge velicine racunaju se direktno u double, istim redom tapova kao
+// osnovne varijante, sa ivicama prema --border=zero|replicate|reflect101|wrap.
+// Transformacije F(4x4) mnoze ulaz sa do 100, pa je greska float zaokruzivanja veca nego kod F(2x2);
+// test() uz vremena ispisuje najvece odstupanje od direktne konvolucije.
+class Convolution_Winograd
+{
+    char* inputFilePath;
+    char* outputFilePath;
+    Mat convolutionKernel;
+    Mat inputImage;
+    BorderMode borderMode;
+    int tileSize;
+    IsaLevel isa;
+    Mat outputImage;
+
+    void convolveDirectSpan(int x, int firstColumn, int lastColumn, uchar* destination);
+    void convolveTileRow(int tileRow, int tileSize, int tileCols, const float* transformedKernel, WinogradBandFunction bandFunction);
+    Mat convolve(int tileSize, bool parallel);
+    Mat convolveDirect(bool parallel);
+
+public:
+    Convolution_Winograd(int argc, char* argv[]);
+    void readArguments(int argc, char* argv[]);
+    void saveImage(Mat image);
+    void setInputImage(Mat image);
+    void setTileSize(int size);
+    Mat performConvolution();
+    Mat performParallelConvolution();
+    String test();
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+
+// Winograd F(m x m, 3 x 3): izlazna plocica m x m racuna se iz ulazne plocice n x n (n = m + 2) kao
+// Y = AT [(G g GT) . (BT d B)] A, gdje je . mnozenje element po element. Transformisani kernel
+// U = G g GT racuna se jednom, pa po plocici ostaje n x n mnozenja umjesto 9 m x m:
+// F(2x2): 16 za 4 izlaza (4 po izlazu), F(4x4): 36 za 16 izlaza (2.25 po izlazu).
+// Kao u osnovnim varijantama racuna se korelacija: izlaz (x, y) je zbir in(x + u - 1, y + v - 1) g(u, v).
+
+// Jedan kanal pojasa plocica: band ima n redova float vrijednosti (razmak bandStride), plocica t cita
+// kolone t*m .. t*m + n - 1; result dobija m redova sa tileCount*m vrijednosti (razmak resultStride)
+typedef void (*WinogradBandFunction)(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride);
+
+void winogradBandF2Scalar(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride);
+void winogradBandF4Scalar(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride);
+// Po 8 plocica u jednom AVX registru (plocica po elementu), ostatak pojasa skalarno
+void winogradBandF2Avx2(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride);
+void winogradBandF4Avx2(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride);
+
+// U = G g GT za kernel 3 x 3 (po redovima); transformed dobija (m + 2) x (m + 2) vrijednosti
+void transformWinogradKernel(const double* kernel, int tileSize, float* transformed);
+
+// Transformacije su sabloni nad tipom T koji ima +, - i mnozenje sa float (float, ili AVX registar
+// sa po jednom plocicom u svakom elementu), a velicina plocice se bira preko dimenzije niza
+
+// BT d B za F(2x2, 3x3): BT = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]
+template <typename T>
+inline void transformWinogradInput(const T (&d)[4][4], T (&v)[4][4])
+{
+    T t[4][4];
+    for (int j = 0; j < 4; j++) {
+        t[0][j] = d[0][j] - d[2][j];
+        t[1][j] = d[1][j] + d[2][j];
+        t[2][j] = d[2][j] - d[1][j];
+        t[3][j] = d[1][j] - d[3][j];
+    }
+    for (int i = 0; i < 4; i++) {
+        v[i][0] = t[i][0] - t[i][2];
+        v[i][1] = t[i][1] + t[i][2];
+        v[i][2] = t[i][2] - t[i][1];
+        v[i][3] = t[i][1] - t[i][3];
+    }
+}
+
+// AT M A za F(2x2, 3x3): AT = [1 1 1 0; 0 1 -1 -1]
+template <typename T>
+inline void transformWinogradOutput(const T (&product)[4][4], T (&y)[2][2])
+{
+    T s[2][4];
+    for (int j = 0; j < 4; j++) {
+        s[0][j] = product[0][j] + product[1][j] + product[2][j];
+        s[1][j] = product[1][j] - product[2][j] - product[3][j];
+    }
+    for (int i = 0; i < 2; i++) {
+        y[i][0] = s[i][0] + s[i][1] + s[i][2];
+        y[i][1] = s[i][1] - s[i][2] - s[i][3];
+    }
+}
+
+// BT d B za F(4x4, 3x3), tacke 0, 1, -1, 2, -2 i beskonacnost:
+// BT = [4 0 -5 0 1 0; 0 -4 -4 1 1 0; 0 4 -4 -1 1 0; 0 -2 -1 2 1 0; 0 2 -1 -2 1 0; 0 4 0 -5 0 1]
+template <typename T>
+inline void transformWinogradInput(const T (&d)[6][6], T (&v)[6][6])
+{
+    T t[6][6];
+    for (int j = 0; j < 6; j++) {
+        t[0][j] = d[0][j] * 4.0f - d[2][j] * 5.0f + d[4][j];
+        t[1][j] = d[3][j] + d[4][j] - (d[1][j] + d[2][j]) * 4.0f;
+        t[2][j] = (d[1][j] - d[2][j]) * 4.0f + d[4][j] - d[3][j];
+        t[3][j] = (d[3][j] - d[1][j]) * 2.0f + d[4][j] - d[2][j];
+        t[4][j] = (d[1][j] - d[3][j]) * 2.0f + d[4][j] - d[2][j];
+        t[5][j] = d[1][j] * 4.0f - d[3][j] * 5.0f + d[5][j];
+    }
+    for (int i = 0; i < 6; i++) {
+        v[i][0] = t[i][0] * 4.0f - t[i][2] * 5.0f + t[i][4];
+        v[i][1] = t[i][3] + t[i][4] - (t[i][1] + t[i][2]) * 4.0f;
+        v[i][2] = (t[i][1] - t[i][2]) * 4.0f + t[i][4] - t[i][3];
+        v[i][3] = (t[i][3] - t[i][1]) * 2.0f + t[i][4] - t[i][2];
+        v[i][4] = (t[i][1] - t[i][3]) * 2.0f + t[i][4] - t[i][2];
+        v[i][5] = t[i][1] * 4.0f - t[i][3] * 5.0f + t[i][5];
+    }
+}
+
+// AT M A za F(4x4, 3x3): AT = [1 1 1 1 1 0; 0 1 -1 2 -2 0; 0 1 1 4 4 0; 0 1 -1 8 -8 1]
+template <typename T>
+inline void transformWinogradOutput(const T (&product)[6][6], T (&y)[4][4])
+{
+    T s[4][6];
+    for (int j = 0; j < 6; j++) {
+        T sum = product[1][j] + product[2][j];
+        T difference = product[1][j] - product[2][j];
+        T farSum = product[3][j] + product[4][j];
+        T farDifference = product[3][j] - product[4][j];
+        s[0][j] = product[0][j] + sum + farSum;
+        s[1][j] = difference + farDifference * 2.0f;
+        s[2][j] = sum + farSum * 4.0f;
+        s[3][j] = difference + farDifference * 8.0f + product[5][j];
+    }
+    for (int i = 0; i < 4; i++) {
+        T sum = s[i][1] + s[i][2];
+        T difference = s[i][1] - s[i][2];
+        T farSum = s[i][3] + s[i][4];
+        T farDifference = s[i][3] - s[i][4];
+        y[i][0] = s[i][0] + sum + farSum;
+        y[i][1] = difference + farDifference * 2.0f;
+        y[i][2] = sum + farSum * 4.0f;
+        y[i][3] = difference + farDifference * 8.0f + s[i][5];
+    }
+}
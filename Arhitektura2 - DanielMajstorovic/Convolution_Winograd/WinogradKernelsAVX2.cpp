@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <immintrin.h>
+
+// Sabloni transformacija iz WinogradKernels.h instanciraju se ovdje nad AVX registrom, pa i oni
+// moraju biti prevedeni za AVX2 (atribut po funkciji ne prelazi na instance sablona); u vcxproj-u
+// fajl ima EnableEnhancedInstructionSet, a za GCC/Clang se cilj postavlja za ostatak fajla
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#include "WinogradKernels.h"
+
+// Osam plocica, po jedna u svakom elementu registra, sa operacijama koje transformacije koriste
+struct WinogradLanes
+{
+	__m256 v;
+};
+
+static inline WinogradLanes operator+(WinogradLanes a, WinogradLanes b)
+{
+	return { _mm256_add_ps(a.v, b.v) };
+}
+
+static inline WinogradLanes operator-(WinogradLanes a, WinogradLanes b)
+{
+	return { _mm256_sub_ps(a.v, b.v) };
+}
+
+static inline WinogradLanes operator*(WinogradLanes a, float factor)
+{
+	return { _mm256_mul_ps(a.v, _mm256_set1_ps(factor)) };
+}
+
+template <int m>
+static void winogradBandAvx2(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride,
+	WinogradBandFunction scalarBand)
+{
+	const int n = m + 2;
+	// Susjedne plocice pocinju m kolona jedna od druge
+	const __m256i tileOffsets = _mm256_setr_epi32(0, m, 2 * m, 3 * m, 4 * m, 5 * m, 6 * m, 7 * m);
+
+	int t = 0;
+	for (; t + 8 <= tileCount; t += 8) {
+		WinogradLanes d[n][n];
+		for (int i = 0; i < n; i++) {
+			const float* row = band + i * bandStride + t * m;
+			for (int j = 0; j < n; j++) {
+				d[i][j].v = _mm256_i32gather_ps(row + j, tileOffsets, 4);
+			}
+		}
+
+		WinogradLanes v[n][n];
+		transformWinogradInput(d, v);
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				v[i][j] = v[i][j] * transformedKernel[i * n + j];
+			}
+		}
+
+		WinogradLanes y[m][m];
+		transformWinogradOutput(v, y);
+
+		// Element l registra y[i][k] je piksel (i, k) plocice t + l
+		alignas(32) float lanes[8];
+		for (int i = 0; i < m; i++) {
+			float* row = result + i * resultStride + t * m;
+			for (int k = 0; k < m; k++) {
+				_mm256_store_ps(lanes, y[i][k].v);
+				for (int l = 0; l < 8; l++) {
+					row[l * m + k] = lanes[l];
+				}
+			}
+		}
+	}
+
+	// Manje od 8 plocica na kraju pojasa
+	if (t < tileCount) {
+		scalarBand(band + t * m, bandStride, tileCount - t, transformedKernel, result + t * m, resultStride);
+	}
+}
+
+void winogradBandF2Avx2(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride)
+{
+	winogradBandAvx2<2>(band, bandStride, tileCount, transformedKernel, result, resultStride, winogradBandF2Scalar);
+}
+
+void winogradBandF4Avx2(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride)
+{
+	winogradBandAvx2<4>(band, bandStride, tileCount, transformedKernel, result, resultStride, winogradBandF4Scalar);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
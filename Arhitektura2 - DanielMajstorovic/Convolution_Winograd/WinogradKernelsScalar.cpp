@@ -0,0 +1,76 @@
+#include "WinogradKernels.h"
+
+// Plocica po plocica, bez vektorskih instrukcija; AVX2 verzija njome racuna ostatak pojasa
+template <int m>
+static void winogradBandScalar(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride)
+{
+	const int n = m + 2;
+	for (int t = 0; t < tileCount; t++) {
+		float d[n][n];
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				d[i][j] = band[i * bandStride + t * m + j];
+			}
+		}
+
+		float v[n][n];
+		transformWinogradInput(d, v);
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				v[i][j] = v[i][j] * transformedKernel[i * n + j];
+			}
+		}
+
+		float y[m][m];
+		transformWinogradOutput(v, y);
+		for (int i = 0; i < m; i++) {
+			for (int k = 0; k < m; k++) {
+				result[i * resultStride + t * m + k] = y[i][k];
+			}
+		}
+	}
+}
+
+void winogradBandF2Scalar(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride)
+{
+	winogradBandScalar<2>(band, bandStride, tileCount, transformedKernel, result, resultStride);
+}
+
+void winogradBandF4Scalar(const float* band, size_t bandStride, int tileCount, const float* transformedKernel, float* result, size_t resultStride)
+{
+	winogradBandScalar<4>(band, bandStride, tileCount, transformedKernel, result, resultStride);
+}
+
+void transformWinogradKernel(const double* kernel, int tileSize, float* transformed)
+{
+	// G za F(2x2, 3x3) i F(4x4, 3x3), isti izbor tacaka kao BT i AT u WinogradKernels.h
+	static const double g2[4][3] = {
+		{ 1, 0, 0 },
+		{ 0.5, 0.5, 0.5 },
+		{ 0.5, -0.5, 0.5 },
+		{ 0, 0, 1 }
+	};
+	static const double g4[6][3] = {
+		{ 1.0 / 4, 0, 0 },
+		{ -1.0 / 6, -1.0 / 6, -1.0 / 6 },
+		{ -1.0 / 6, 1.0 / 6, -1.0 / 6 },
+		{ 1.0 / 24, 1.0 / 12, 1.0 / 6 },
+		{ 1.0 / 24, -1.0 / 12, 1.0 / 6 },
+		{ 0, 0, 1 }
+	};
+	int n = tileSize + 2;
+	const double* g = tileSize == 2 ? &g2[0][0] : &g4[0][0];
+
+	// U = G g GT u double, pa tek rezultat u float
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < n; j++) {
+			double sum = 0;
+			for (int u = 0; u < 3; u++) {
+				for (int v = 0; v < 3; v++) {
+					sum += g[i * 3 + u] * kernel[u * 3 + v] * g[j * 3 + v];
+				}
+			}
+			transformed[i * n + j] = (float)sum;
+		}
+	}
+}
@@ -0,0 +1,5 @@
+@echo off
+title Paketna obrada
+"..\x64\Debug\Arhitektura2.exe" ".\Slike\Ulaz" ".\Slike\Rezultat\Paket" -1 -1 -1 2 2 2 -1 -1 -1 --batch
+
+pause
\ No newline at end of file
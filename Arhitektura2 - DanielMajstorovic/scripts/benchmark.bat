@@ -0,0 +1,5 @@
+@echo off
+title Benchmark
+"..\x64\Debug\ConvolutionBenchmark.exe" --sizes=3,4,5,6,7 --kernels=3,5,7 --repetitions=30 --json=".\benchmark.json" --csv=".\benchmark.csv"
+
+pause
\ No newline at end of file
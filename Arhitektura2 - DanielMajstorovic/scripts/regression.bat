@@ -0,0 +1,5 @@
+@echo off
+title Regresija
+"..\x64\Debug\Arhitektura2.exe" - ".\Slike\regresija" --regression
+
+pause
\ No newline at end of file